@@ -196,6 +196,95 @@ function StationList::StationList_Vehicle()
 	}
 }
 
+function StationList::PrintValuateCompare(name, native_list, script_list)
+{
+	local same = native_list.Count() == script_list.Count();
+	for (local i = native_list.Begin(); !native_list.IsEnd(); i = native_list.Next()) {
+		if (!script_list.HasItem(i) || script_list.GetValue(i) != native_list.GetValue(i)) same = false;
+	}
+	print("  " + name + " same as Valuate(): " + same);
+	print("  " + name + " ListDump:");
+	for (local i = native_list.Begin(); !native_list.IsEnd(); i = native_list.Next()) {
+		print("    " + i + " => " + native_list.GetValue(i));
+	}
+}
+
+function StationList::NativeValuators()
+{
+	print("");
+	print("--NativeValuators--");
+
+	local native = AIStationList(AIStation.STATION_BUS_STOP + AIStation.STATION_TRUCK_STOP);
+	local script = AIStationList(AIStation.STATION_BUS_STOP + AIStation.STATION_TRUCK_STOP);
+	native.ValuateCargoWaiting(0);
+	script.Valuate(AIStation.GetCargoWaiting, 0);
+	PrintValuateCompare("Station ValuateCargoWaiting(0)", native, script);
+	native.ValuateCargoRating(1);
+	script.Valuate(AIStation.GetCargoRating, 1);
+	PrintValuateCompare("Station ValuateCargoRating(1)", native, script);
+	native.ValuateDistanceManhattanToTile(30000);
+	script.Valuate(AIStation.GetDistanceManhattanToTile, 30000);
+	PrintValuateCompare("Station ValuateDistanceManhattanToTile(30000)", native, script);
+
+	native = AIStationList_Vehicle(12);
+	script = AIStationList_Vehicle(12);
+	native.ValuateCargoWaiting(0);
+	script.Valuate(AIStation.GetCargoWaiting, 0);
+	PrintValuateCompare("StationList_Vehicle ValuateCargoWaiting(0)", native, script);
+
+	native = AITileList();
+	native.AddRectangle(33411, 33418 + 4 * AIMap.GetMapSizeX());
+	script = AITileList();
+	script.AddList(native);
+	native.ValuateBuildable();
+	script.Valuate(AITile.IsBuildable);
+	PrintValuateCompare("Tile ValuateBuildable()", native, script);
+	native.ValuateSlope();
+	script.Valuate(AITile.GetSlope);
+	PrintValuateCompare("Tile ValuateSlope()", native, script);
+	native.ValuateMaxHeight();
+	script.Valuate(AITile.GetMaxHeight);
+	PrintValuateCompare("Tile ValuateMaxHeight()", native, script);
+	native.ValuateOwner();
+	script.Valuate(AITile.GetOwner);
+	PrintValuateCompare("Tile ValuateOwner()", native, script);
+	native.ValuateDistanceManhattanToTile(30000);
+	script.Valuate(AITile.GetDistanceManhattanToTile, 30000);
+	PrintValuateCompare("Tile ValuateDistanceManhattanToTile(30000)", native, script);
+	native.ValuateCargoAcceptance(0, 1, 1, 3);
+	script.Valuate(AITile.GetCargoAcceptance, 0, 1, 1, 3);
+	PrintValuateCompare("Tile ValuateCargoAcceptance(0, 1, 1, 3)", native, script);
+
+	native = AIVehicleList();
+	script = AIVehicleList();
+	native.ValuateAge();
+	script.Valuate(AIVehicle.GetAge);
+	PrintValuateCompare("Vehicle ValuateAge()", native, script);
+	native.ValuateState();
+	script.Valuate(AIVehicle.GetState);
+	PrintValuateCompare("Vehicle ValuateState()", native, script);
+	native.ValuateProfitThisYear();
+	script.Valuate(AIVehicle.GetProfitThisYear);
+	PrintValuateCompare("Vehicle ValuateProfitThisYear()", native, script);
+	native.ValuateProfitLastYear();
+	script.Valuate(AIVehicle.GetProfitLastYear);
+	PrintValuateCompare("Vehicle ValuateProfitLastYear()", native, script);
+	native.ValuateReliability();
+	script.Valuate(AIVehicle.GetReliability);
+	PrintValuateCompare("Vehicle ValuateReliability()", native, script);
+	native.ValuateVehicleType();
+	script.Valuate(AIVehicle.GetVehicleType);
+	PrintValuateCompare("Vehicle ValuateVehicleType()", native, script);
+
+	native = AITileList();
+	native.AddRectangle(0, 31 + 31 * AIMap.GetMapSizeX());
+	local count = native.Count();
+	AIController.Sleep(1);
+	local ops = AIController.GetOpsTillSuspend();
+	native.ValuateBuildable();
+	print("  Native valuation of " + count + " items charges ops per item: " + (ops - AIController.GetOpsTillSuspend() >= 5 * count));
+}
+
 function StationList::Start()
 {
 	StationList();
@@ -211,4 +300,5 @@ function StationList::Start()
 	StationList_CargoWaitingViaByFrom();
 	StationList_CargoWaitingFromByVia();
 	StationList_Vehicle();
+	NativeValuators();
 }
@@ -17,6 +17,7 @@
 #include "../framerate_type.h"
 #include "../scope_info.h"
 #include "../string_func.h"
+#include "../memory_accounting.h"
 #include "ai_scanner.hpp"
 #include "ai_instance.hpp"
 #include "ai_config.hpp"
@@ -29,6 +30,16 @@
 /* static */ AIScannerInfo *AI::scanner_info = nullptr;
 /* static */ AIScannerLibrary *AI::scanner_library = nullptr;
 
+static MemoryAccountingRegistration _ai_memory_accounting("AI scripts", []() -> MemoryAccountingSample {
+	MemoryAccountingSample sample = { 0, 0 };
+	for (const Company *c : Company::Iterate()) {
+		if (c->ai_instance == nullptr) continue;
+		sample.bytes += c->ai_instance->GetAllocatedMemory();
+		sample.count++;
+	}
+	return sample;
+});
+
 /* static */ bool AI::CanStartNew()
 {
 	/* Only allow new AIs on the server and only when that is allowed in multiplayer */
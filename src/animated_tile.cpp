@@ -16,12 +16,38 @@
 #include "framerate_type.h"
 #include "date_func.h"
 #include "3rdparty/cpp-btree/btree_map.h"
+#include "3rdparty/cpp-btree/btree_set.h"
+
+#include <algorithm>
+#include <vector>
 
 #include "safeguards.h"
 
 /** The table/list with animated tiles. */
 btree::btree_map<TileIndex, AnimatedTileInfo> _animated_tiles;
 
+/**
+ * Number of animation speeds which can be due, a tile with speed s is animated every 2^s ticks.
+ * Tiles with a higher speed are never animated, see AnimateAnimatedTiles.
+ */
+static const uint ANIMATED_TILE_SPEED_BUCKETS = 33;
+
+/** Animated tiles which are not pending deletion, bucketed by their speed. */
+static btree::btree_set<TileIndex> _animated_tile_speed_buckets[ANIMATED_TILE_SPEED_BUCKETS];
+
+/** Tiles which were marked as pending deletion since the animated tile table was last swept. */
+static std::vector<TileIndex> _animated_tiles_pending_deletion;
+
+static void AddAnimatedTileToSpeedBucket(TileIndex tile, uint8 speed)
+{
+	if (speed < ANIMATED_TILE_SPEED_BUCKETS) _animated_tile_speed_buckets[speed].insert(tile);
+}
+
+static void RemoveAnimatedTileFromSpeedBucket(TileIndex tile, uint8 speed)
+{
+	if (speed < ANIMATED_TILE_SPEED_BUCKETS) _animated_tile_speed_buckets[speed].erase(tile);
+}
+
 /**
  * Removes the given tile from the animated tile table.
  * @param tile the tile to remove
@@ -31,6 +57,8 @@ void DeleteAnimatedTile(TileIndex tile)
 	auto to_remove = _animated_tiles.find(tile);
 	if (to_remove != _animated_tiles.end() && !to_remove->second.pending_deletion) {
 		to_remove->second.pending_deletion = true;
+		RemoveAnimatedTileFromSpeedBucket(tile, to_remove->second.speed);
+		_animated_tiles_pending_deletion.push_back(tile);
 		MarkTileDirtyByTile(tile, VMDF_NOT_MAP_MODE);
 	}
 }
@@ -73,9 +101,12 @@ static void UpdateAnimatedTileSpeed(TileIndex tile, AnimatedTileInfo &info)
 void AddAnimatedTile(TileIndex tile)
 {
 	MarkTileDirtyByTile(tile, VMDF_NOT_MAP_MODE);
-	AnimatedTileInfo &info = _animated_tiles[tile];
+	auto result = _animated_tiles.insert({ tile, {} });
+	AnimatedTileInfo &info = result.first->second;
+	if (!result.second && !info.pending_deletion) RemoveAnimatedTileFromSpeedBucket(tile, info.speed);
 	UpdateAnimatedTileSpeed(tile, info);
 	info.pending_deletion = false;
+	AddAnimatedTileToSpeedBucket(tile, info.speed);
 }
 
 int GetAnimatedTileSpeed(TileIndex tile)
@@ -89,6 +120,7 @@ int GetAnimatedTileSpeed(TileIndex tile)
 
 /**
  * Animate all tiles in the animated tile list, i.e.\ call AnimateTile on them.
+ * Only the tiles which are due this tick are visited, in tile order.
  */
 void AnimateAnimatedTiles()
 {
@@ -99,40 +131,66 @@ void AnimateAnimatedTiles()
 
 	PerformanceAccumulator framerate(PFE_GL_LANDSCAPE);
 
+	for (TileIndex tile : _animated_tiles_pending_deletion) {
+		auto iter = _animated_tiles.find(tile);
+		if (iter != _animated_tiles.end() && iter->second.pending_deletion) _animated_tiles.erase(iter);
+	}
+	_animated_tiles_pending_deletion.clear();
+
 	const uint32 ticks = (uint) _scaled_tick_counter;
 	const uint8 max_speed = (ticks == 0) ? 32 : FindFirstBit(ticks);
 
-	auto iter = _animated_tiles.begin();
-	while (iter != _animated_tiles.end()) {
-		if (iter->second.pending_deletion) {
-			iter = _animated_tiles.erase(iter);
-			continue;
-		}
+	/* Tiles with speed s are due every 2^s ticks, merge the due buckets into tile order.
+	 * The tiles are copied out as animating a tile may add or delete animated tiles. */
+	static std::vector<TileIndex> due_tiles;
+	due_tiles.clear();
+	for (uint8 speed = 0; speed <= max_speed; speed++) {
+		const btree::btree_set<TileIndex> &bucket = _animated_tile_speed_buckets[speed];
+		if (bucket.empty()) continue;
+		const size_t merged = due_tiles.size();
+		due_tiles.insert(due_tiles.end(), bucket.begin(), bucket.end());
+		if (merged != 0) std::inplace_merge(due_tiles.begin(), due_tiles.begin() + merged, due_tiles.end());
+	}
 
-		if (iter->second.speed <= max_speed) {
-			const TileIndex curr = iter->first;
-			switch (GetTileType(curr)) {
-				case MP_HOUSE:
-					AnimateTile_Town(curr);
-					break;
+	for (const TileIndex curr : due_tiles) {
+		/* Skip tiles which were deleted, or re-added with a speed which is not due, by animating an earlier tile. */
+		const auto iter = _animated_tiles.find(curr);
+		if (iter == _animated_tiles.end() || iter->second.pending_deletion || iter->second.speed > max_speed) continue;
 
-				case MP_STATION:
-					AnimateTile_Station(curr);
-					break;
+		switch (GetTileType(curr)) {
+			case MP_HOUSE:
+				AnimateTile_Town(curr);
+				break;
 
-				case MP_INDUSTRY:
-					AnimateTile_Industry(curr);
-					break;
+			case MP_STATION:
+				AnimateTile_Station(curr);
+				break;
 
-				case MP_OBJECT:
-					AnimateTile_Object(curr);
-					break;
+			case MP_INDUSTRY:
+				AnimateTile_Industry(curr);
+				break;
 
-				default:
-					NOT_REACHED();
-			}
+			case MP_OBJECT:
+				AnimateTile_Object(curr);
+				break;
+
+			default:
+				NOT_REACHED();
 		}
-		++iter;
+	}
+}
+
+/**
+ * Rebuild the speed buckets of the animated tiles from the animated tile table.
+ * Must be called after the table is modified other than through AddAnimatedTile and DeleteAnimatedTile, e.g.\ when loading.
+ */
+void RebuildAnimatedTileSpeedBuckets()
+{
+	for (btree::btree_set<TileIndex> &bucket : _animated_tile_speed_buckets) {
+		bucket.clear();
+	}
+	for (const auto &it : _animated_tiles) {
+		if (!it.second.pending_deletion) AddAnimatedTileToSpeedBucket(it.first, it.second.speed);
 	}
 }
 
@@ -147,6 +205,7 @@ void UpdateAllAnimatedTileSpeeds()
 		UpdateAnimatedTileSpeed(iter->first, iter->second);
 		++iter;
 	}
+	RebuildAnimatedTileSpeedBuckets();
 }
 
 /**
@@ -155,4 +214,6 @@ void UpdateAllAnimatedTileSpeeds()
 void InitializeAnimatedTiles()
 {
 	_animated_tiles.clear();
+	_animated_tiles_pending_deletion.clear();
+	RebuildAnimatedTileSpeedBuckets();
 }
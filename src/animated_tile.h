@@ -20,4 +20,6 @@ struct AnimatedTileInfo {
 
 extern btree::btree_map<TileIndex, AnimatedTileInfo> _animated_tiles;
 
+void RebuildAnimatedTileSpeedBuckets();
+
 #endif /* ANIMATED_TILE_H */
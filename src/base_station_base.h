@@ -18,7 +18,7 @@
 #include "core/tinystring_type.hpp"
 #include <memory>
 
-typedef Pool<BaseStation, StationID, 32, 64000> StationPool;
+typedef Pool<BaseStation, StationID, 32, 64000, PT_NORMAL, false, true, true> StationPool;
 extern StationPool _station_pool;
 
 struct StationSpecList {
@@ -182,6 +182,7 @@ struct BaseStation : StationPool::PoolItem<&_station_pool> {
 	}
 
 	static void PostDestructor(size_t index);
+	static size_t GetPoolSlotSize();
 
 private:
 	void FillCachedName() const;
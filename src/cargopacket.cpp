@@ -18,6 +18,7 @@
 #include "core/backup_type.hpp"
 #include "string_func.h"
 #include "strings_func.h"
+#include "memory_accounting.h"
 #include "3rdparty/cpp-btree/btree_map.h"
 
 #include <vector>
@@ -30,6 +31,10 @@ INSTANTIATE_POOL_METHODS(CargoPacket)
 
 btree::btree_map<uint64, Money> _cargo_packet_deferred_payments;
 
+static MemoryAccountingRegistration _cargo_packet_deferred_payments_memory_accounting("CargoPacket deferred payments", []() -> MemoryAccountingSample {
+	return { _cargo_packet_deferred_payments.bytes_used(), _cargo_packet_deferred_payments.size() };
+});
+
 void ClearCargoPacketDeferredPayments() {
 	_cargo_packet_deferred_payments.clear();
 }
@@ -275,6 +275,7 @@ CommandProc CmdChangePlanColour;
 CommandProc CmdRenamePlan;
 
 CommandProc CmdDesyncCheck;
+CommandProc CmdStateChecksums;
 
 #define DEF_CMD(proc, flags, type) Command(proc, #proc, (CommandFlags)flags, type)
 
@@ -508,6 +509,7 @@ static const Command _command_proc_table[] = {
 	DEF_CMD(CmdRenamePlan,                           CMD_NO_TEST, CMDT_OTHER_MANAGEMENT      ), // CMD_RENAME_PLAN
 
 	DEF_CMD(CmdDesyncCheck,                           CMD_SERVER, CMDT_SERVER_SETTING        ), // CMD_DESYNC_CHECK
+	DEF_CMD(CmdStateChecksums,                        CMD_SERVER, CMDT_SERVER_SETTING        ), // CMD_STATE_CHECKSUMS
 };
 
 
@@ -457,6 +457,7 @@ enum Commands {
 	CMD_RENAME_PLAN,
 
 	CMD_DESYNC_CHECK,                 ///< Force desync checks to be run
+	CMD_STATE_CHECKSUMS,              ///< Calculate and compare the state checksums of the server and clients
 
 	CMD_END,                          ///< Must ALWAYS be on the end of this list!! (period)
 };
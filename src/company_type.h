@@ -49,6 +49,7 @@ typedef Owner CompanyID;
 typedef uint16 CompanyMask;
 
 struct Company;
+struct CompanyInfrastructure;
 typedef uint32 CompanyManagerFace; ///< Company manager face bits, info see in company_manager_face.h
 
 /** The reason why the company was removed. */
@@ -53,6 +53,8 @@
 #include "linkgraph/linkgraphjob.h"
 #include "base_media_base.h"
 #include "debug_settings.h"
+#include "state_checksum.h"
+#include "memory_accounting.h"
 #include <time.h>
 
 #include "safeguards.h"
@@ -1497,12 +1499,13 @@ DEF_CONSOLE_CMD(ConAlias)
 DEF_CONSOLE_CMD(ConScreenShot)
 {
 	if (argc == 0) {
-		IConsoleHelp("Create a screenshot of the game. Usage: 'screenshot [viewport | normal | big | giant | world | heightmap | minimap] [no_con] [size <width> <height>] [<filename>]'");
+		IConsoleHelp("Create a screenshot of the game. Usage: 'screenshot [viewport | normal | big | giant | world | tiles | heightmap | minimap] [no_con] [size <width> <height>] [<filename>]'");
 		IConsoleHelp("'viewport' (default) makes a screenshot of the current viewport (including menus, windows, ..), "
 				"'normal' makes a screenshot of the visible area, "
 				"'big' makes a zoomed-in screenshot of the visible area, "
 				"'giant' makes a screenshot of the whole map using the default zoom level, "
 				"'world' makes a screenshot of the whole map using the current zoom level, "
+				"'tiles' makes a directory of image tiles of the whole map at all zoom levels from the 'giant' one outwards, for use with web map viewers, "
 				"'heightmap' makes a heightmap screenshot of the map that can be loaded in as heightmap, "
 				"'minimap' makes a top-viewed minimap screenshot of the whole world which represents one tile by one pixel. "
 				"'no_con' hides the console to create the screenshot (only useful in combination with 'viewport'). "
@@ -1534,6 +1537,9 @@ DEF_CONSOLE_CMD(ConScreenShot)
 		} else if (strcmp(argv[arg_index], "world") == 0) {
 			type = SC_WORLD_ZOOM;
 			arg_index += 1;
+		} else if (strcmp(argv[arg_index], "tiles") == 0) {
+			type = SC_WORLD_TILES;
+			arg_index += 1;
 		} else if (strcmp(argv[arg_index], "heightmap") == 0) {
 			type = SC_HEIGHTMAP;
 			arg_index += 1;
@@ -2310,6 +2316,50 @@ DEF_CONSOLE_CMD(ConMapStats)
 	return true;
 }
 
+DEF_CONSOLE_CMD(ConDumpMemoryStats)
+{
+	if (argc == 0 || argc > 2 || (argc == 2 && strcmp(argv[1], "reset") != 0)) {
+		IConsoleHelp("Dump memory used by pools, caches and scripts. Usage: 'dump_memory_stats [reset]'");
+		IConsoleHelp("  reset: restart tracking the peaks from the current usage.");
+		return true;
+	}
+
+	if (argc == 2) ResetMemoryAccountingPeaks();
+
+	char buffer[16384];
+	DumpMemoryAccounting(buffer, lastof(buffer));
+	PrintLineByLine(buffer);
+	return true;
+}
+
+DEF_CONSOLE_CMD(ConDumpProgSigStats)
+{
+	if (argc == 0) {
+		IConsoleHelp("Dump programmable signal slot/counter dependant update stats.");
+		return true;
+	}
+
+	extern void DumpProgrammableSignalDependantUpdateStats(char *b, const char *last);
+	char buffer[1024];
+	DumpProgrammableSignalDependantUpdateStats(buffer, lastof(buffer));
+	PrintLineByLine(buffer);
+	return true;
+}
+
+DEF_CONSOLE_CMD(ConDumpLinkRefreshStats)
+{
+	if (argc == 0) {
+		IConsoleHelp("Dump link refresher run stats.");
+		return true;
+	}
+
+	extern void DumpLinkRefreshStats(char *b, const char *last);
+	char buffer[1024];
+	DumpLinkRefreshStats(buffer, lastof(buffer));
+	PrintLineByLine(buffer);
+	return true;
+}
+
 DEF_CONSOLE_CMD(ConStFlowStats)
 {
 	if (argc == 0) {
@@ -2685,6 +2735,50 @@ DEF_CONSOLE_CMD(ConCheckCaches)
 	return true;
 }
 
+DEF_CONSOLE_CMD(ConStateChecksums)
+{
+	if (argc == 0) {
+		IConsoleHelp("Debug: Show the per-subsystem state checksums. Usage: 'state_checksums [<broadcast>]'");
+		IConsoleHelp("  With broadcast 1 on a server, all clients report their checksums for the same tick, and mismatches are written to the desync log.");
+		return true;
+	}
+
+	if (argc > 2) return false;
+
+	bool broadcast = (argc == 2 && atoi(argv[1]) > 0 && (!_networking || _network_server));
+	if (broadcast) {
+		DoCommandP(0, 0, 0, CMD_STATE_CHECKSUMS);
+	} else {
+		StateChecksumTree tree;
+		tree.Calculate();
+		char buffer[4096];
+		tree.Dump(buffer, lastof(buffer));
+		PrintLineByLine(buffer);
+	}
+
+	return true;
+}
+
+DEF_CONSOLE_CMD(ConCheckCachesBudget)
+{
+	if (argc < 1 || argc > 2) {
+		IConsoleHelp("Debug: Incremental cache checks. Usage: 'check_caches_budget [<microseconds>]'");
+		IConsoleHelp("  Checks a rotating subset of the caches each tick, using up to the given time per tick. 0 disables.");
+		return true;
+	}
+
+	extern uint _check_caches_budget;
+	if (argc == 1) {
+		IConsolePrintF(CC_DEFAULT, "Incremental cache check budget: %u us per tick", _check_caches_budget);
+	} else {
+		uint32 budget;
+		if (!GetArgumentInteger(&budget, argv[1])) return false;
+		_check_caches_budget = budget;
+	}
+
+	return true;
+}
+
 DEF_CONSOLE_CMD(ConShowTownWindow)
 {
 	if (argc != 2) {
@@ -3448,6 +3542,9 @@ void IConsoleStdLibRegister()
 	IConsole::CmdRegister("dump_veh_stats",          ConVehicleStats,     nullptr, true);
 	IConsole::CmdRegister("dump_map_stats",          ConMapStats,         nullptr, true);
 	IConsole::CmdRegister("dump_st_flow_stats",      ConStFlowStats,      nullptr, true);
+	IConsole::CmdRegister("dump_progsig_stats",      ConDumpProgSigStats, nullptr, true);
+	IConsole::CmdRegister("dump_link_refresh_stats", ConDumpLinkRefreshStats, nullptr, true);
+	IConsole::CmdRegister("dump_memory_stats",       ConDumpMemoryStats,  nullptr, true);
 	IConsole::CmdRegister("dump_game_events",        ConDumpGameEvents,   nullptr, true);
 	IConsole::CmdRegister("dump_load_debug_log",     ConDumpLoadDebugLog, nullptr, true);
 	IConsole::CmdRegister("dump_load_debug_config",  ConDumpLoadDebugConfig, nullptr, true);
@@ -3458,6 +3555,8 @@ void IConsoleStdLibRegister()
 	IConsole::CmdRegister("dump_cargo_types",        ConDumpCargoTypes,   nullptr, true);
 	IConsole::CmdRegister("dump_tile",               ConDumpTile,         nullptr, true);
 	IConsole::CmdRegister("check_caches",            ConCheckCaches,      nullptr, true);
+	IConsole::CmdRegister("check_caches_budget",     ConCheckCachesBudget, nullptr, true);
+	IConsole::CmdRegister("state_checksums",         ConStateChecksums,   nullptr, true);
 	IConsole::CmdRegister("show_town_window",        ConShowTownWindow,   nullptr, true);
 	IConsole::CmdRegister("show_station_window",     ConShowStationWindow, nullptr, true);
 	IConsole::CmdRegister("show_industry_window",    ConShowIndustryWindow, nullptr, true);
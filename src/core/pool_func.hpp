@@ -21,8 +21,8 @@
  * @param type The return type of the method.
  */
 #define DEFINE_POOL_METHOD(type) \
-	template <class Titem, typename Tindex, size_t Tgrowth_step, size_t Tmax_size, PoolType Tpool_type, bool Tcache, bool Tzero> \
-	type Pool<Titem, Tindex, Tgrowth_step, Tmax_size, Tpool_type, Tcache, Tzero>
+	template <class Titem, typename Tindex, size_t Tgrowth_step, size_t Tmax_size, PoolType Tpool_type, bool Tcache, bool Tzero, bool Tchunked> \
+	type Pool<Titem, Tindex, Tgrowth_step, Tmax_size, Tpool_type, Tcache, Tzero, Tchunked>
 
 /**
  * Create a clean pool.
@@ -35,15 +35,64 @@ DEFINE_POOL_METHOD(inline)::Pool(const char *name) :
 		first_free(0),
 		first_unused(0),
 		items(0),
+		peak_items(0),
 #ifdef OTTD_ASSERT
 		checked(0),
 #endif /* OTTD_ASSERT */
 		cleaning(false),
 		data(nullptr),
 		free_bitmap(nullptr),
+		full_bitmap(nullptr),
+		chunks(nullptr),
+		chunk_bytes(0),
+		chunk_end(0),
 		alloc_cache(nullptr)
 { }
 
+/**
+ * Get the size of a slot of a chunk, when Tchunked is enabled.
+ * @return size of a slot, aligned for Titem
+ */
+DEFINE_POOL_METHOD(inline size_t)::GetChunkSlotSize()
+{
+	return Align(Titem::GetPoolSlotSize(), alignof(Titem));
+}
+
+/**
+ * Check whether a chunk contains no items, when Tchunked is enabled.
+ * @param chunk index of the chunk
+ * @return true if no slot of the chunk is in use
+ */
+DEFINE_POOL_METHOD(inline bool)::IsChunkEmpty(size_t chunk) const
+{
+	const size_t begin = chunk * CHUNK_ITEMS / 64;
+	const size_t end = std::min((chunk + 1) * CHUNK_ITEMS, this->size);
+	for (size_t i = begin; i < end / 64; i++) {
+		if (this->free_bitmap[i] != 0) return false;
+	}
+	/* The bits beyond the size of the pool are marked as used, ignore them. */
+	if (end % 64 != 0 && GB(this->free_bitmap[end / 64], 0, end % 64) != 0) return false;
+	return true;
+}
+
+/**
+ * Free the empty chunks at the end of the pool, when Tchunked is enabled.
+ * One empty chunk is kept, so that a pool size oscillating around a chunk
+ * boundary does not allocate and free that chunk repeatedly.
+ */
+DEFINE_POOL_METHOD(inline void)::FreeTrailingChunks()
+{
+	while (this->chunk_end >= 2 && this->IsChunkEmpty(this->chunk_end - 1) && this->IsChunkEmpty(this->chunk_end - 2)) {
+		byte *&chunk = this->chunks[this->chunk_end - 1];
+		if (chunk != nullptr) {
+			free(chunk);
+			chunk = nullptr;
+			this->chunk_bytes -= CHUNK_ITEMS * GetChunkSlotSize();
+		}
+		this->chunk_end--;
+	}
+}
+
 /**
  * Resizes the pool so 'index' can be addressed
  * @param index index we will allocate later
@@ -66,6 +115,14 @@ DEFINE_POOL_METHOD(inline void)::ResizeFor(size_t index)
 		this->free_bitmap[new_size / 64] |= (~((uint64) 0)) << (new_size % 64);
 	}
 
+	this->full_bitmap = ReallocT(this->full_bitmap, CeilDiv(new_size, 64 * 64));
+	MemSetT(this->full_bitmap + CeilDiv(this->size, 64 * 64), 0, CeilDiv(new_size, 64 * 64) - CeilDiv(this->size, 64 * 64));
+
+	if (Tchunked) {
+		this->chunks = ReallocT(this->chunks, CeilDiv(new_size, CHUNK_ITEMS));
+		MemSetT(this->chunks + CeilDiv(this->size, CHUNK_ITEMS), 0, CeilDiv(new_size, CHUNK_ITEMS) - CeilDiv(this->size, CHUNK_ITEMS));
+	}
+
 	this->size = new_size;
 }
 
@@ -78,9 +135,18 @@ DEFINE_POOL_METHOD(inline size_t)::FindFirstFree()
 	uint bitmap_index = this->first_free / 64;
 	uint bitmap_end = CeilDiv(this->first_unused, 64);
 
-	for (; bitmap_index < bitmap_end; bitmap_index++) {
+	while (bitmap_index < bitmap_end) {
+		/* Skip words of the free bitmap which are completely used, 64 at a time. */
+		uint64 not_full = ~this->full_bitmap[bitmap_index / 64] >> (bitmap_index % 64);
+		if (not_full == 0) {
+			bitmap_index = Align(bitmap_index + 1, 64);
+			continue;
+		}
+		bitmap_index += FindFirstBit64(not_full);
+		if (bitmap_index >= bitmap_end) break;
+
 		uint64 available = ~this->free_bitmap[bitmap_index];
-		if (available == 0) continue;
+		assert(available != 0);
 		return (bitmap_index * 64) + FindFirstBit64(available);
 	}
 
@@ -113,6 +179,7 @@ DEFINE_POOL_METHOD(inline void *)::AllocateItem(size_t size, size_t index)
 
 	this->first_unused = std::max(this->first_unused, index + 1);
 	this->items++;
+	if (this->items > this->peak_items) this->peak_items = this->items;
 
 	Titem *item;
 	if (Tcache && this->alloc_cache != nullptr) {
@@ -124,6 +191,19 @@ DEFINE_POOL_METHOD(inline void *)::AllocateItem(size_t size, size_t index)
 			 * we are actually memsetting a (not-yet-constructed) object */
 			memset((void *)item, 0, sizeof(Titem));
 		}
+	} else if (Tchunked) {
+		const size_t slot_size = GetChunkSlotSize();
+		assert(size <= slot_size);
+		byte *&chunk = this->chunks[index / CHUNK_ITEMS];
+		if (chunk == nullptr) {
+			chunk = MallocT<byte>(CHUNK_ITEMS * slot_size);
+			this->chunk_bytes += CHUNK_ITEMS * slot_size;
+			this->chunk_end = std::max(this->chunk_end, index / CHUNK_ITEMS + 1);
+		}
+		item = (Titem *)(chunk + (index % CHUNK_ITEMS) * slot_size);
+		if (Tzero) {
+			memset((void *)item, 0, size);
+		}
 	} else if (Tzero) {
 		item = (Titem *)CallocT<byte>(size);
 	} else {
@@ -131,6 +211,7 @@ DEFINE_POOL_METHOD(inline void *)::AllocateItem(size_t size, size_t index)
 	}
 	this->data[index] = item;
 	SetBit(this->free_bitmap[index / 64], index % 64);
+	if (this->free_bitmap[index / 64] == ~((uint64) 0)) SetBit(this->full_bitmap[index / (64 * 64)], (index / 64) % 64);
 	item->index = (Tindex)(uint)index;
 	return item;
 }
@@ -195,14 +276,16 @@ DEFINE_POOL_METHOD(void)::FreeItem(size_t index)
 		AllocCache *ac = (AllocCache *)this->data[index];
 		ac->next = this->alloc_cache;
 		this->alloc_cache = ac;
-	} else {
+	} else if (!Tchunked) {
 		free(this->data[index]);
 	}
 	this->data[index] = nullptr;
 	ClrBit(this->free_bitmap[index / 64], index % 64);
+	ClrBit(this->full_bitmap[index / (64 * 64)], (index / 64) % 64);
 	this->first_free = std::min(this->first_free, index);
 	this->items--;
 	if (!this->cleaning) Titem::PostDestructor(index);
+	if (Tchunked && !this->cleaning && index / CHUNK_ITEMS + 2 >= this->chunk_end) this->FreeTrailingChunks();
 }
 
 /** Destroys all items in the pool and resets all member variables. */
@@ -214,11 +297,22 @@ DEFINE_POOL_METHOD(void)::CleanPool()
 		delete this->Get(i); // 'delete nullptr;' is very valid
 	}
 	assert(this->items == 0);
+	if (Tchunked) {
+		for (size_t i = 0; i < CeilDiv(this->size, CHUNK_ITEMS); i++) {
+			free(this->chunks[i]);
+		}
+		free(this->chunks);
+		this->chunks = nullptr;
+		this->chunk_bytes = 0;
+		this->chunk_end = 0;
+	}
 	free(this->data);
 	free(this->free_bitmap);
+	free(this->full_bitmap);
 	this->first_unused = this->first_free = this->size = 0;
 	this->data = nullptr;
 	this->free_bitmap = nullptr;
+	this->full_bitmap = nullptr;
 	this->cleaning = false;
 
 	if (Tcache) {
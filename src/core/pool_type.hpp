@@ -58,6 +58,30 @@ struct PoolBase {
 	 */
 	virtual void CleanPool() = 0;
 
+	/** Memory used by a pool. */
+	struct MemoryUsage {
+		size_t items;      ///< Number of items in the pool.
+		size_t peak_items; ///< Highest number of items in the pool since the last reset.
+		size_t bytes;      ///< Bytes used by the items, sized as the pool's item type, and by the pool's own arrays.
+	};
+
+	/**
+	 * Virtual method that gets the name of the pool.
+	 * @return the name
+	 */
+	virtual const char *GetName() const = 0;
+
+	/**
+	 * Virtual method that gets the memory used by the pool.
+	 * @return the memory usage
+	 */
+	virtual MemoryUsage GetMemoryUsage() const = 0;
+
+	/**
+	 * Virtual method that resets the peak number of items to the current number.
+	 */
+	virtual void ResetPeakUsage() = 0;
+
 private:
 	/**
 	 * Dummy private copy constructor to prevent compilers from
@@ -75,14 +99,23 @@ private:
  * @tparam Tpool_type   Type of this pool
  * @tparam Tcache       Whether to perform 'alloc' caching, i.e. don't actually free/malloc just reuse the memory
  * @tparam Tzero        Whether to zero the memory
+ * @tparam Tchunked     Whether to store the items in contiguous chunks of slots, in index order, instead of allocating each separately
  * @warning when Tcache is enabled *all* instances of this pool's item must be of the same size.
+ * @warning when Tchunked is enabled *all* instances of this pool's item must fit in PoolItem::GetPoolSlotSize().
  */
-template <class Titem, typename Tindex, size_t Tgrowth_step, size_t Tmax_size, PoolType Tpool_type = PT_NORMAL, bool Tcache = false, bool Tzero = true>
+template <class Titem, typename Tindex, size_t Tgrowth_step, size_t Tmax_size, PoolType Tpool_type = PT_NORMAL, bool Tcache = false, bool Tzero = true, bool Tchunked = false>
 struct Pool : PoolBase {
 	/* Ensure Tmax_size is within the bounds of Tindex. */
 	static_assert((uint64)(Tmax_size - 1) >> 8 * sizeof(Tindex) == 0);
 
+	/* Chunked slots are never freed individually, so there is nothing to cache. */
+	static_assert(!(Tcache && Tchunked));
+
 	static constexpr size_t MAX_SIZE = Tmax_size; ///< Make template parameter accessible from outside
+	static constexpr size_t CHUNK_ITEMS = Tgrowth_step < 64 ? 64 : Tgrowth_step; ///< Number of slots per chunk when Tchunked is enabled, the same as the growth step of the pool
+
+	/* Chunks must cover whole words of the free bitmap. */
+	static_assert(!Tchunked || CHUNK_ITEMS % 64 == 0);
 
 	const char * const name; ///< Name of this pool
 
@@ -90,6 +123,7 @@ struct Pool : PoolBase {
 	size_t first_free;   ///< No item with index lower than this is free (doesn't say anything about this one!)
 	size_t first_unused; ///< This and all higher indexes are free (doesn't say anything about first_unused-1 !)
 	size_t items;        ///< Number of used indexes (non-nullptr)
+	size_t peak_items;   ///< Highest number of used indexes since the last ResetPeakUsage
 #ifdef OTTD_ASSERT
 	size_t checked;      ///< Number of items we checked for
 #endif /* OTTD_ASSERT */
@@ -97,10 +131,24 @@ struct Pool : PoolBase {
 
 	Titem **data;        ///< Pointer to array of pointers to Titem
 	uint64 *free_bitmap; ///< Pointer to free bitmap
+	uint64 *full_bitmap; ///< Pointer to bitmap of which words of the free bitmap are completely used
+	byte **chunks;       ///< Pointer to array of chunks of item slots, when Tchunked is enabled
+	size_t chunk_bytes;  ///< Bytes allocated for chunks of item slots
+	size_t chunk_end;    ///< One past the highest chunk which may be allocated, when Tchunked is enabled
 
 	Pool(const char *name);
 	virtual void CleanPool();
 
+	const char *GetName() const override { return this->name; }
+
+	MemoryUsage GetMemoryUsage() const override
+	{
+		const size_t item_bytes = Tchunked ? this->chunk_bytes + ((this->size + CHUNK_ITEMS - 1) / CHUNK_ITEMS) * sizeof(byte *) : this->items * sizeof(Titem);
+		return { this->items, this->peak_items, item_bytes + this->size * sizeof(Titem *) + ((this->size + 63) / 64 + (this->size + 4095) / 4096) * sizeof(uint64) };
+	}
+
+	void ResetPeakUsage() override { this->peak_items = this->items; }
+
 	/**
 	 * Returns Titem with given index
 	 * @param index of item to get
@@ -223,12 +271,12 @@ struct Pool : PoolBase {
 	 * Base class for all PoolItems
 	 * @tparam Tpool The pool this item is going to be part of
 	 */
-	template <struct Pool<Titem, Tindex, Tgrowth_step, Tmax_size, Tpool_type, Tcache, Tzero> *Tpool>
+	template <struct Pool<Titem, Tindex, Tgrowth_step, Tmax_size, Tpool_type, Tcache, Tzero, Tchunked> *Tpool>
 	struct PoolItem {
 		Tindex index; ///< Index of this pool item
 
 		/** Type of the pool this item is going to be part of */
-		typedef struct Pool<Titem, Tindex, Tgrowth_step, Tmax_size, Tpool_type, Tcache, Tzero> Pool;
+		typedef struct Pool<Titem, Tindex, Tgrowth_step, Tmax_size, Tpool_type, Tcache, Tzero, Tchunked> Pool;
 
 		/**
 		 * Allocates space for new Titem
@@ -378,6 +426,13 @@ struct Pool : PoolBase {
 		 */
 		static inline void PreCleanPool() { }
 
+		/**
+		 * Size of the slots of a chunked pool, which must fit the largest type of item in the pool.
+		 * If the pool contains types derived from Titem, override it in PoolItem's subclass.
+		 * @return size of a slot
+		 */
+		static inline size_t GetPoolSlotSize() { return sizeof(Titem); }
+
 		/**
 		 * Returns an iterable ensemble of all valid Titem
 		 * @param from index of the first Titem to consider
@@ -401,6 +456,9 @@ private:
 	/** Cache of freed pointers */
 	AllocCache *alloc_cache;
 
+	static size_t GetChunkSlotSize();
+	bool IsChunkEmpty(size_t chunk) const;
+	void FreeTrailingChunks();
 	void *AllocateItem(size_t size, size_t index);
 	void ResizeFor(size_t index);
 	size_t FindFirstFree();
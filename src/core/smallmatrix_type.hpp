@@ -266,6 +266,11 @@ public:
 		return this->width;
 	}
 
+	inline uint Capacity() const
+	{
+		return this->capacity;
+	}
+
 	/**
 	 * Get item x/y (const).
 	 *
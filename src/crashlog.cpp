@@ -484,11 +484,12 @@ char *CrashLog::FillDesyncCrashLog(char *buffer, const char *last, const DesyncE
 		auto flag_check = [&](DesyncExtraInfo::Flags flag, const char *str) {
 			return info.flags & flag ? str : "";
 		};
-		buffer += seprintf(buffer, last, "Flags: %s%s%s%s\n",
+		buffer += seprintf(buffer, last, "Flags: %s%s%s%s%s\n",
 				flag_check(DesyncExtraInfo::DEIF_RAND1, "R"),
 				flag_check(DesyncExtraInfo::DEIF_RAND2, "Z"),
 				flag_check(DesyncExtraInfo::DEIF_STATE, "S"),
-				flag_check(DesyncExtraInfo::DEIF_DBL_RAND, "D"));
+				flag_check(DesyncExtraInfo::DEIF_DBL_RAND, "D"),
+				flag_check(DesyncExtraInfo::DEIF_STATE_TREE, "T"));
 	}
 
 	buffer += seprintf(buffer, last, "In game date: %i-%02i-%02i (%i, %i) (DL: %u)\n", _cur_date_ymd.year, _cur_date_ymd.month + 1, _cur_date_ymd.day, _date_fract, _tick_skip_counter, _settings_game.economy.day_length_factor);
@@ -20,6 +20,7 @@ struct DesyncExtraInfo {
 		DEIF_RAND2      = 1 << 1, ///< random 2 mismatch
 		DEIF_STATE      = 1 << 2, ///< state mismatch
 		DEIF_DBL_RAND   = 1 << 3, ///< double-seed sent
+		DEIF_STATE_TREE = 1 << 4, ///< state checksum tree mismatch
 	};
 
 	Flags flags = DEIF_NONE;
@@ -22,6 +22,7 @@
 #include "console_func.h"
 #include "debug.h"
 #include "landscape.h"
+#include "memory_accounting.h"
 #include "widgets/statusbar_widget.h"
 
 #include "safeguards.h"
@@ -272,6 +273,7 @@ static void OnNewDay()
 		NewGRFProfiler::FinishAll();
 	}
 
+	UpdateMemoryAccounting();
 	if (_network_server) NetworkServerDailyLoop();
 
 	DisasterDailyLoop();
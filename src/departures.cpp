@@ -96,41 +96,17 @@ static inline bool VehicleSetNextDepartureTime(DateTicks *previous_departure, ui
 				/* This condition means that we want departure time for the first order */
 				/* but not if the vehicle has arrived at the first order because the timetable is already shifted */
 				if (iterating_order == order && !(arrived_at_timing_point && v->cur_implicit_order_index == j)) {
-					DateTicksScaled actual_departure    = -1;
-					const DateTicksScaled begin_time    = v->orders.list->GetScheduledDispatchStartTick();
-					const uint32 dispatch_duration      = v->orders.list->GetScheduledDispatchDuration();
-					const int32 max_delay               = v->orders.list->GetScheduledDispatchDelay();
-
-					/* Earliest possible departure according to schedue */
-					DateTicksScaled earliest_departure = begin_time + v->orders.list->GetScheduledDispatchLastDispatch();
-
 					/* Earliest possible departure according to vehicle current timetable */
-					if (earliest_departure + max_delay < date_only_scaled + *previous_departure + order->GetTravelTime()) {
-						earliest_departure = date_only_scaled + *previous_departure + order->GetTravelTime() - max_delay - 1;
-						/* -1 because this number is actually a moment before actual departure */
-					}
-
-					/* Find next available slots */
-					for (auto current_offset : v->orders.list->GetScheduledDispatch()) {
-						if (current_offset >= dispatch_duration) continue;
-						DateTicksScaled current_departure = begin_time + current_offset;
-						while (current_departure <= earliest_departure) {
-							current_departure += dispatch_duration;
-						}
+					const DateTicksScaled earliest_departure = date_only_scaled + *previous_departure + order->GetTravelTime() - v->orders.list->GetScheduledDispatchDelay() - 1;
+					/* -1 because this number is actually a moment before actual departure */
 
-						/* Make sure the slots has not already been used previously in this departure board calculation */
-						while (dept_schedule_last[v->orders.list->index].count(current_departure) > 0) {
-							current_departure += dispatch_duration;
-						}
-
-						if (actual_departure == -1 || actual_departure > current_departure) {
-							actual_departure = current_departure;
-						}
-					}
+					/* Find next available slot, which has not already been used previously in this departure board calculation */
+					std::set<DateTicksScaled> &used_slots = dept_schedule_last[v->orders.list->index];
+					const DateTicksScaled actual_departure = v->orders.list->GetScheduledDispatchNextSlot(earliest_departure, &used_slots);
 
 					*waiting_time = order->GetWaitTime() + actual_departure - date_only_scaled - *previous_departure - order->GetTravelTime();
 					*previous_departure = actual_departure - date_only_scaled + order->GetWaitTime();
-					dept_schedule_last[v->orders.list->index].insert(actual_departure);
+					used_slots.insert(actual_departure);
 
 					/* Return true means that vehicle lateness should be clear from this point onward */
 					return true;
@@ -215,8 +191,7 @@ DepartureList* MakeDepartureList(StationID station, const std::vector<const Vehi
 	/* As an overview, it works by repeatedly considering the best possible next departure to show. */
 	/* By best possible we mean the one expected to arrive at the station first. */
 	/* However, we do not consider departures whose scheduled time is too far in the future, even if they are expected before some delayed ones. */
-	/* This code can probably be made more efficient. I haven't done so in order to keep both its (relative) simplicity and my (relative) sanity. */
-	/* Having written that, it's not exactly slow at the moment. */
+	/* The remaining candidates are kept in a sorted queue, so finding each next departure is logarithmic in the number of vehicles. */
 
 	/* The list of departures which will be returned as a result. */
 	std::vector<Departure*> *result = new std::vector<Departure*>();
@@ -402,6 +377,30 @@ DepartureList* MakeDepartureList(StationID station, const std::vector<const Vehi
 		return result;
 	}
 
+	/* Date by which candidates are sorted when choosing the next least order. */
+	auto get_sort_date = [&](const OrderDate *od) -> DateTicks {
+		DateTicks date = od->expected_date - od->lateness;
+		if (type == D_ARRIVAL) date -= od->scheduled_waiting_time > 0 ? od->scheduled_waiting_time : od->order->GetWaitTime();
+		return date;
+	};
+
+	/* Candidates other than the least order, sorted by sort date and then by index in next_orders. */
+	/* A candidate's sort date only changes when it is the least order, so each one can be queued once it stops being the least order. */
+	/* Candidates scheduled too late can never become the least order again, so are not queued. */
+	std::set<std::pair<DateTicks, uint>> candidate_queue;
+	auto queue_candidate = [&](uint index) {
+		const OrderDate *od = next_orders[index];
+		if (od->expected_date - od->lateness < max_date) candidate_queue.insert(std::make_pair(get_sort_date(od), index));
+	};
+	uint least_order_index = 0;
+	for (uint i = 0; i < next_orders.size(); ++i) {
+		if (next_orders[i] == least_order) {
+			least_order_index = i;
+		} else {
+			queue_candidate(i);
+		}
+	}
+
 	/* We now find as many departures as we can. It's a little involved so I'll try to explain each major step. */
 	/* The countdown from 10000 is a safeguard just in case something nasty happens. 10000 seemed large enough. */
 	for(int i = 10000; i > 0; --i) {
@@ -776,20 +775,14 @@ DepartureList* MakeDepartureList(StationID station, const std::vector<const Vehi
 		}
 
 		/* Find the new least order. */
-		for (uint i = 0; i < next_orders.size(); ++i) {
-			OrderDate *od = next_orders[i];
-
-			DateTicks lod = least_order->expected_date - least_order->lateness;
-			DateTicks odd = od->expected_date - od->lateness;
-
-			if (type == D_ARRIVAL) {
-				lod -= least_order->scheduled_waiting_time > 0 ? least_order->scheduled_waiting_time : least_order->order->GetWaitTime();
-				odd -= od->scheduled_waiting_time > 0 ? od->scheduled_waiting_time : od->order->GetWaitTime();
-			}
-
-			if (lod > odd && od->expected_date - od->lateness < max_date) {
-				least_order = od;
-			}
+		/* The least order is the candidate with the earliest sort date, preferring the current least order and then the earliest candidate on ties. */
+		DateTicks lod = get_sort_date(least_order);
+		if (!candidate_queue.empty() && candidate_queue.begin()->first < lod) {
+			const uint next_index = candidate_queue.begin()->second;
+			candidate_queue.erase(candidate_queue.begin());
+			queue_candidate(least_order_index);
+			least_order_index = next_index;
+			least_order = next_orders[least_order_index];
 		}
 	}
 
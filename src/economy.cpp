@@ -543,6 +543,8 @@ void ChangeOwnershipOfCompanyItems(Owner old_owner, Owner new_owner)
 			st->owner = new_owner == INVALID_OWNER ? OWNER_NONE : new_owner;
 		}
 	}
+	/* Both the station owners and the town exclusive rights may have changed */
+	InvalidateAllIndustryStationCandidates();
 
 	/* do the same for waypoints (we need to do this here so deleted waypoints are converted too) */
 	for (Waypoint *wp : Waypoint::Iterate()) {
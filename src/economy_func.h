@@ -15,6 +15,7 @@
 #include "cargo_type.h"
 #include "vehicle_type.h"
 #include "company_type.h"
+#include <vector>
 
 void ResetPriceBaseMultipliers();
 void SetPriceBaseMultiplier(Price price, int factor);
@@ -30,6 +31,8 @@ void StartupIndustryDailyChanges(bool init_counter);
 
 Money GetTransportedGoodsIncome(uint num_pieces, uint dist, byte transit_days, CargoID cargo_type);
 uint MoveGoodsToStation(CargoID type, uint amount, SourceType source_type, SourceID source_id, const StationList *all_stations, Owner exclusivity = INVALID_OWNER);
+uint MoveGoodsToStation(CargoID type, uint amount, SourceType source_type, SourceID source_id, const std::vector<Station *> &candidates);
+bool IsStationExcludedFromGoods(const Station *st, Owner exclusivity);
 
 void PrepareUnload(Vehicle *front_v);
 void LoadUnloadStation(Station *st);
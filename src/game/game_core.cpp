@@ -14,6 +14,7 @@
 #include "../network/network.h"
 #include "../window_func.h"
 #include "../framerate_type.h"
+#include "../memory_accounting.h"
 #include "game.hpp"
 #include "game_scanner.hpp"
 #include "game_config.hpp"
@@ -28,6 +29,11 @@
 /* static */ GameScannerInfo *Game::scanner_info = nullptr;
 /* static */ GameScannerLibrary *Game::scanner_library = nullptr;
 
+static MemoryAccountingRegistration _game_memory_accounting("Game script", []() -> MemoryAccountingSample {
+	if (Game::GetInstance() == nullptr) return { 0, 0 };
+	return { Game::GetInstance()->GetAllocatedMemory(), 1 };
+});
+
 /* static */ void Game::GameLoop()
 {
 	if (_networking && !_network_server) {
@@ -190,6 +190,7 @@ static void _GenerateWorld()
 		if (_gw.proc != nullptr) _gw.proc();
 		IncreaseGeneratingWorldProgress(GWP_GAME_START);
 
+		if (_gw.mode != GWM_EMPTY) ReportGeneratingWorldTimings();
 		CleanupGeneration();
 
 		ShowNewGRFError();
@@ -98,6 +98,7 @@ void SetNewLandscapeType(byte landscape);
 void SetGeneratingWorldProgress(GenWorldProgress cls, uint total);
 void IncreaseGeneratingWorldProgress(GenWorldProgress cls);
 void PrepareGenerateWorldProgress();
+void ReportGeneratingWorldTimings();
 void ShowGenerateWorldProgress();
 void StartNewGameWithoutGUI(uint32 seed);
 void ShowCreateScenario();
@@ -1449,6 +1449,9 @@ struct GenWorldStatus {
 	uint current;
 	uint total;
 	std::chrono::steady_clock::time_point next_update;
+	int stage;                                             ///< Current stage, or -1 before the first one.
+	std::chrono::steady_clock::time_point stage_start;     ///< Start time of the current stage.
+	std::chrono::steady_clock::duration stage_time[GWP_CLASS_COUNT]; ///< Time spent in each stage.
 };
 
 static GenWorldStatus _gws;
@@ -1469,6 +1472,32 @@ static const StringID _generation_class_table[]  = {
 };
 static_assert(lengthof(_generation_class_table) == GWP_CLASS_COUNT);
 
+/** Names of the stages in the stage timings. */
+static const char * const _generation_class_names[] = {
+	"map init",
+	"landscape",
+	"rivers",
+	"rough/rocky",
+	"towns",
+	"industries",
+	"objects",
+	"trees",
+	"game init",
+	"tile loop",
+	"game script",
+	"game start",
+};
+static_assert(lengthof(_generation_class_names) == GWP_CLASS_COUNT);
+
+/** Add the time spent since the start of the current stage to that stage, and start timing a new stage. */
+static void StartGeneratingWorldStage(int stage)
+{
+	const auto now = std::chrono::steady_clock::now();
+	if (_gws.stage >= 0) _gws.stage_time[_gws.stage] += now - _gws.stage_start;
+	_gws.stage = stage;
+	_gws.stage_start = now;
+}
+
 
 static void AbortGeneratingWorldCallback(Window *w, bool confirmed)
 {
@@ -1555,6 +1584,37 @@ void PrepareGenerateWorldProgress()
 	_gws.total = 0;
 	_gws.percent = 0;
 	_gws.next_update = std::chrono::steady_clock::now();
+	_gws.stage = -1;
+	for (auto &time : _gws.stage_time) time = {};
+}
+
+/**
+ * Report the time spent in each stage of the world generation.
+ * Dedicated servers report it along with the progress, otherwise it is a map debug message.
+ */
+void ReportGeneratingWorldTimings()
+{
+	if (!HasModalProgress()) return;
+
+	StartGeneratingWorldStage(-1);
+
+	char buffer[512];
+	char *p = buffer;
+	const char *last = lastof(buffer);
+	std::chrono::steady_clock::duration total = {};
+	p += seprintf(p, last, "Map generation stage times:");
+	for (uint i = 0; i < GWP_CLASS_COUNT; i++) {
+		if (_gws.stage_time[i] == std::chrono::steady_clock::duration::zero()) continue;
+		total += _gws.stage_time[i];
+		p += seprintf(p, last, " %s: %u ms,", _generation_class_names[i], (uint)std::chrono::duration_cast<std::chrono::milliseconds>(_gws.stage_time[i]).count());
+	}
+	seprintf(p, last, " total: %u ms", (uint)std::chrono::duration_cast<std::chrono::milliseconds>(total).count());
+
+	if (_network_dedicated) {
+		DEBUG(net, 1, "%s", buffer);
+	} else {
+		DEBUG(map, 1, "%s", buffer);
+	}
 }
 
 /**
@@ -1588,6 +1648,7 @@ static void _SetGeneratingWorldProgress(GenWorldProgress cls, uint progress, uin
 		_gws.current += progress;
 		assert(_gws.current <= _gws.total);
 	} else {
+		if (_gws.stage != (int)cls) StartGeneratingWorldStage(cls);
 		_gws.cls     = _generation_class_table[cls];
 		_gws.current = progress;
 		_gws.total   = total;
@@ -89,6 +89,8 @@ struct Industry : IndustryPool::PoolItem<&_industry_pool> {
 
 	PartOfSubsidy part_of_subsidy;      ///< NOSAVE: is this industry a source/destination of a subsidy?
 	StationList stations_near;          ///< NOSAVE: List of nearby stations.
+	std::vector<Station *> station_candidates; ///< NOSAVE: Stations of stations_near not excluded by exclusive rights, in station index order, see GetStationCandidates()
+	uint32 station_candidates_generation;      ///< NOSAVE: Generation of station_candidates, it is stale when this differs from the current generation
 	mutable std::string cached_name;    ///< NOSAVE: Cache of the resolved name of the industry
 
 	Owner founder;                      ///< Founder of the industry
@@ -108,6 +110,7 @@ struct Industry : IndustryPool::PoolItem<&_industry_pool> {
 	~Industry();
 
 	void RecomputeProductionMultipliers();
+	const std::vector<Station *> &GetStationCandidates();
 
 	/**
 	 * Check if a given tile belongs to this industry.
@@ -202,6 +205,7 @@ protected:
 };
 
 void ClearAllIndustryCachedNames();
+void InvalidateAllIndustryStationCandidates();
 
 void PlantRandomFarmField(const Industry *i);
 
@@ -11,6 +11,7 @@
 #include "clear_map.h"
 #include "industry.h"
 #include "station_base.h"
+#include "station_func.h"
 #include "landscape.h"
 #include "viewport_func.h"
 #include "command_func.h"
@@ -44,6 +45,9 @@
 #include "cmd_helper.h"
 #include "string_func.h"
 
+#include <algorithm>
+#include <array>
+
 #include "table/strings.h"
 #include "table/industry_land.h"
 #include "table/build_industry.h"
@@ -65,6 +69,162 @@ IndustrySpec _industry_specs[NUM_INDUSTRYTYPES];
 IndustryTileSpec _industry_tile_specs[NUM_INDUSTRYTILES];
 IndustryBuildData _industry_builder; ///< In-game manager of industries.
 
+/**
+ * Spatial index of the industries, for the distance and per town checks when placing new industries.
+ * Industries are kept in a grid of cells by the north tile of their location, and in a list per industry type.
+ * This is not saved; it is built from the industry pool on first use after it has been reset.
+ */
+class IndustryLocationIndex {
+	static const uint CELL_BITS = 4; ///< Log2 of the size of a cell, in tiles.
+
+	std::vector<std::vector<IndustryID>> cells;                     ///< Industries per cell, in row major order.
+	std::array<std::vector<IndustryID>, NUM_INDUSTRYTYPES> types;   ///< Industries per type.
+	uint cells_x = 0;                                               ///< Number of cells in the X direction.
+	uint cells_y = 0;                                               ///< Number of cells in the Y direction.
+	bool valid = false;                                             ///< Whether the index is built.
+
+	inline uint GetCellIndex(TileIndex tile) const
+	{
+		return (TileY(tile) >> CELL_BITS) * this->cells_x + (TileX(tile) >> CELL_BITS);
+	}
+
+	static void RemoveID(std::vector<IndustryID> &list, IndustryID index)
+	{
+		auto it = std::find(list.begin(), list.end(), index);
+		if (it != list.end()) {
+			*it = list.back();
+			list.pop_back();
+		}
+	}
+
+	void Add(const Industry *i)
+	{
+		this->cells[this->GetCellIndex(i->location.tile)].push_back(i->index);
+		this->types[i->type].push_back(i->index);
+	}
+
+	void Build()
+	{
+		this->cells_x = (MapSizeX() + (1 << CELL_BITS) - 1) >> CELL_BITS;
+		this->cells_y = (MapSizeY() + (1 << CELL_BITS) - 1) >> CELL_BITS;
+		this->cells.assign(this->cells_x * this->cells_y, std::vector<IndustryID>());
+		for (std::vector<IndustryID> &list : this->types) list.clear();
+		for (const Industry *i : Industry::Iterate()) {
+			if (i->location.w != 0) this->Add(i);
+		}
+		this->valid = true;
+	}
+
+	inline void EnsureValid()
+	{
+		if (!this->valid) this->Build();
+	}
+
+public:
+	/** Forget the contents of the index, it is rebuilt when next used. */
+	void Reset()
+	{
+		this->cells.clear();
+		for (std::vector<IndustryID> &list : this->types) list.clear();
+		this->valid = false;
+	}
+
+	/**
+	 * Add a new industry to the index.
+	 * @param i The industry, its location and type must be final.
+	 */
+	void Insert(const Industry *i)
+	{
+		if (this->valid) this->Add(i);
+	}
+
+	/**
+	 * Remove an industry from the index.
+	 * @param i The industry.
+	 */
+	void Remove(const Industry *i)
+	{
+		if (!this->valid) return;
+		RemoveID(this->cells[this->GetCellIndex(i->location.tile)], i->index);
+		RemoveID(this->types[i->type], i->index);
+	}
+
+	/**
+	 * Get all industries of a given type, in no particular order.
+	 * @param type The industry type.
+	 * @return The IDs of the industries of this type.
+	 */
+	const std::vector<IndustryID> &GetIndustriesOfType(IndustryType type)
+	{
+		this->EnsureValid();
+		return this->types[type];
+	}
+
+	/**
+	 * Test whether any industry with the north tile of its location near a tile matches a predicate.
+	 * @param tile The tile to look around.
+	 * @param distance Maximum distance (DistanceMax) from \a tile to the north tile of the industry location.
+	 * @param predicate Predicate to test the industries with.
+	 * @return True iff the predicate returned true for any of the industries in range.
+	 */
+	template <typename F>
+	bool AnyNear(TileIndex tile, uint distance, F predicate)
+	{
+		this->EnsureValid();
+		const uint x = TileX(tile);
+		const uint y = TileY(tile);
+		const uint cx_first = (x - std::min(x, distance)) >> CELL_BITS;
+		const uint cy_first = (y - std::min(y, distance)) >> CELL_BITS;
+		const uint cx_last = std::min(MapMaxX(), x + distance) >> CELL_BITS;
+		const uint cy_last = std::min(MapMaxY(), y + distance) >> CELL_BITS;
+		for (uint cy = cy_first; cy <= cy_last; cy++) {
+			for (uint cx = cx_first; cx <= cx_last; cx++) {
+				for (IndustryID index : this->cells[cy * this->cells_x + cx]) {
+					const Industry *i = Industry::Get(index);
+					if (DistanceMax(tile, i->location.tile) <= distance && predicate(i)) return true;
+				}
+			}
+		}
+		return false;
+	}
+
+	/**
+	 * Check the index against the industry pool.
+	 * @return True iff the index is not built, or contains exactly the industries in the pool.
+	 */
+	bool Validate() const
+	{
+		if (!this->valid) return true;
+
+		IndustryLocationIndex check;
+		check.Build();
+		auto same_contents = [](std::vector<IndustryID> a, std::vector<IndustryID> b) {
+			std::sort(a.begin(), a.end());
+			std::sort(b.begin(), b.end());
+			return a == b;
+		};
+		if (check.cells.size() != this->cells.size()) return false;
+		for (size_t c = 0; c < this->cells.size(); c++) {
+			if (!same_contents(this->cells[c], check.cells[c])) return false;
+		}
+		for (size_t t = 0; t < this->types.size(); t++) {
+			if (!same_contents(this->types[t], check.types[t])) return false;
+		}
+		return true;
+	}
+};
+
+static IndustryLocationIndex _industry_location_index;
+
+/**
+ * Check the spatial index of the industries against the industry pool.
+ * @return True iff the index is consistent.
+ */
+bool ValidateIndustryLocationIndex()
+{
+	return _industry_location_index.Validate();
+}
+
 /**
  * This function initialize the spec arrays of both
  * industry and industry tiles.
@@ -154,6 +314,7 @@ Industry::~Industry()
 		if (IsTileType(tile_cur, MP_INDUSTRY)) {
 			if (GetIndustryIndex(tile_cur) == this->index) {
 				DeleteNewGRFInspectWindow(GSF_INDUSTRYTILES, tile_cur);
+				RemoveTileFromStationAcceptanceCaches(tile_cur);
 
 				/* MakeWaterKeepingClass() can also handle 'land' */
 				MakeWaterKeepingClass(tile_cur, OWNER_NONE);
@@ -189,6 +350,7 @@ Industry::~Industry()
 	delete this->psa;
 
 	DecIndustryTypeCount(this->type);
+	_industry_location_index.Remove(this);
 
 	DeleteIndustryNews(this->index);
 	DeleteWindowById(WC_INDUSTRY_VIEW, this->index);
@@ -545,7 +707,7 @@ static bool TransportIndustryGoods(TileIndex tile)
 
 			i->this_month_production[j] += cw;
 
-			uint am = MoveGoodsToStation(i->produced_cargo[j], cw, ST_INDUSTRY, i->index, &i->stations_near, i->exclusive_consumer);
+			uint am = MoveGoodsToStation(i->produced_cargo[j], cw, ST_INDUSTRY, i->index, i->GetStationCandidates());
 			i->this_month_transported[j] += am;
 
 			moved_cargo |= (am != 0);
@@ -995,7 +1157,10 @@ static void ChangeTileOwner_Industry(TileIndex tile, Owner old_owner, Owner new_
 	if (i->founder == old_owner) i->founder = (new_owner == INVALID_OWNER) ? OWNER_NONE : new_owner;
 
 	if (i->exclusive_supplier == old_owner) i->exclusive_supplier = new_owner;
-	if (i->exclusive_consumer == old_owner) i->exclusive_consumer = new_owner;
+	if (i->exclusive_consumer == old_owner) {
+		i->exclusive_consumer = new_owner;
+		i->station_candidates_generation = 0;
+	}
 }
 
 /**
@@ -1184,6 +1349,25 @@ static void ProduceIndustryGoodsFromRate(Industry *i, bool scale)
 
 static uint _scaled_production_ticks;
 
+/**
+ * Check whether #ProduceIndustryGoods has to do anything other than decrement the counter of an industry this tick.
+ * @param i Industry to check, before its counter has been decremented.
+ * @return True if the industry plays a sound, produces cargo or runs a production callback this tick.
+ */
+static inline bool IsIndustryProductionDue(const Industry *i)
+{
+	/* Sound check, this also draws a random number */
+	if ((i->counter & 0x3F) == 0) return true;
+
+	const uint16 counter = i->counter - 1;
+	if ((counter % INDUSTRY_PRODUCE_TICKS) == 0) return true;
+	if (_settings_game.economy.industry_cargo_scale_factor != 0 && (counter % _scaled_production_ticks) == 0 &&
+			HasBit(GetIndustrySpec(i->type)->callback_mask, CBM_IND_PRODUCTION_256_TICKS)) {
+		return true;
+	}
+	return false;
+}
+
 static void ProduceIndustryGoods(Industry *i)
 {
 	const IndustrySpec *indsp = GetIndustrySpec(i->type);
@@ -1274,9 +1458,21 @@ void OnTick_Industry()
 	if (_game_mode == GM_EDITOR) return;
 
 	_scaled_production_ticks = ScaleQuantity(INDUSTRY_PRODUCE_TICKS, -_settings_game.economy.industry_cargo_scale_factor);
+
+	/* Most industries only need their counter decrementing on any given tick,
+	 * so do that in one pass and only run the full production step for the industries which are due. */
+	static std::vector<Industry *> due_industries;
 	for (Industry *i : Industry::Iterate()) {
+		if (IsIndustryProductionDue(i)) {
+			due_industries.push_back(i);
+		} else {
+			i->counter--;
+		}
+	}
+	for (Industry *i : due_industries) {
 		ProduceIndustryGoods(i);
 	}
+	due_industries.clear();
 }
 
 /**
@@ -1461,8 +1657,8 @@ static CommandCost FindTownForIndustry(TileIndex tile, int type, Town **t)
 
 	if (_settings_game.economy.multiple_industry_per_town) return CommandCost();
 
-	for (const Industry *i : Industry::Iterate()) {
-		if (i->type == (byte)type && i->town == *t) {
+	for (IndustryID index : _industry_location_index.GetIndustriesOfType(type)) {
+		if (Industry::Get(index)->town == *t) {
 			*t = nullptr;
 			return_cmd_error(STR_ERROR_ONLY_ONE_ALLOWED_PER_TOWN);
 		}
@@ -1706,38 +1902,14 @@ static CommandCost CheckIfFarEnoughFromConflictingIndustry(TileIndex tile, int t
 {
 	const IndustrySpec *indspec = GetIndustrySpec(type);
 
-	/* On a large map with many industries, it may be faster to check an area. */
-	static const int dmax = 14;
-	if (Industry::GetNumItems() > (size_t) (dmax * dmax * 2)) {
-		const Industry* i = nullptr;
-		TileArea tile_area = TileArea(tile, 1, 1).Expand(dmax);
-		TILE_AREA_LOOP(atile, tile_area) {
-			if (GetTileType(atile) == MP_INDUSTRY) {
-				const Industry *i2 = Industry::GetByTile(atile);
-				if (i == i2) continue;
-				i = i2;
-				if (DistanceMax(tile, i->location.tile) > (uint)dmax) continue;
-				if (i->type == indspec->conflicting[0] ||
-						i->type == indspec->conflicting[1] ||
-						i->type == indspec->conflicting[2]) {
-					return_cmd_error(STR_ERROR_INDUSTRY_TOO_CLOSE);
-				}
-			}
-		}
-		return CommandCost();
-	}
-
-	for (const Industry *i : Industry::Iterate()) {
-		/* Within 14 tiles from another industry is considered close */
-		if (DistanceMax(tile, i->location.tile) > 14) continue;
-
-		/* check if there are any conflicting industry types around */
-		if (i->type == indspec->conflicting[0] ||
+	/* Within 14 tiles from another industry is considered close; check if there are any conflicting industry types around */
+	bool conflict = _industry_location_index.AnyNear(tile, 14, [indspec](const Industry *i) {
+		return i->type == indspec->conflicting[0] ||
 				i->type == indspec->conflicting[1] ||
-				i->type == indspec->conflicting[2]) {
-			return_cmd_error(STR_ERROR_INDUSTRY_TOO_CLOSE);
-		}
-	}
+				i->type == indspec->conflicting[2];
+	});
+	if (conflict) return_cmd_error(STR_ERROR_INDUSTRY_TOO_CLOSE);
+
 	return CommandCost();
 }
 
@@ -1767,6 +1939,8 @@ static void AdvertiseIndustryOpening(const Industry *ind)
  */
 static void PopulateStationsNearby(Industry *ind)
 {
+	ind->station_candidates_generation = 0;
+
 	if (ind->neutral_station != nullptr && !_settings_game.station.serve_neutral_industries) {
 		/* Industry has a neutral station. Use it and ignore any other nearby stations. */
 		ind->stations_near.insert(ind->neutral_station);
@@ -1958,6 +2132,7 @@ static void DoCreateNewIndustry(Industry *i, TileIndex tile, IndustryType type,
 			DoCommand(cur_tile, 0, 0, DC_EXEC | DC_NO_TEST_TOWN_RATING | DC_NO_MODIFY_TOWN_RATING, CMD_LANDSCAPE_CLEAR);
 
 			MakeIndustry(cur_tile, i->index, it.gfx, Random(), wc);
+			AddTileToStationAcceptanceCaches(cur_tile);
 
 			if (_generating_world) {
 				SetIndustryConstructionCounter(cur_tile, 3);
@@ -1971,6 +2146,8 @@ static void DoCreateNewIndustry(Industry *i, TileIndex tile, IndustryType type,
 		}
 	}
 
+	_industry_location_index.Insert(i);
+
 	if (GetIndustrySpec(i->type)->behaviour & INDUSTRYBEH_PLANT_ON_BUILT) {
 		for (uint j = 0; j != 50; j++) PlantRandomFarmField(i);
 	}
@@ -2177,6 +2354,7 @@ CommandCost CmdIndustryCtrl(TileIndex tile, DoCommandFlag flags, uint32 p1, uint
 					ind->exclusive_supplier = company_id;
 				} else {
 					ind->exclusive_consumer = company_id;
+					ind->station_candidates_generation = 0;
 				}
 			}
 
@@ -2197,6 +2375,26 @@ CommandCost CmdIndustryCtrl(TileIndex tile, DoCommandFlag flags, uint32 p1, uint
 	return CommandCost();
 }
 
+/**
+ * Cheaply check whether a location could be suitable for a new industry, before the costly checks of all the industry tiles.
+ * This only does checks which CreateNewIndustryHelper performs as well and which have no side effects,
+ * so rejecting a location early does not change the outcome of trying to build there.
+ * @param tile North tile of the new industry.
+ * @param type Type of the new industry.
+ * @return False if the industry can certainly not be built at \a tile.
+ */
+static bool IsPossibleNewIndustryLocation(TileIndex tile, IndustryType type)
+{
+	const IndustrySpec *indspec = GetIndustrySpec(type);
+
+	/* The per type checks may look at tiles south of the north tile; leave locations at the map edge to the full checks. */
+	if (TileX(tile) + 1 >= MapMaxX() || TileY(tile) + 1 >= MapMaxY()) return true;
+
+	if (!HasBit(indspec->callback_mask, CBM_IND_LOCATION) && _check_new_industry_procs[indspec->check_proc](tile).Failed()) return false;
+
+	return CheckIfFarEnoughFromConflictingIndustry(tile, type).Succeeded();
+}
+
 /**
  * Create a new industry of random layout.
  * @param tile The location to build the industry.
@@ -2212,6 +2410,7 @@ static Industry *CreateNewIndustry(TileIndex tile, IndustryType type, IndustryAv
 	uint32 seed2 = Random();
 	Industry *i = nullptr;
 	size_t layout_index = RandomRange((uint32)indspec->layouts.size());
+	if (!IsPossibleNewIndustryLocation(tile, type)) return nullptr;
 	CommandCost ret = CreateNewIndustryHelper(tile, type, DC_EXEC, indspec, layout_index, seed, GB(seed2, 0, 16), OWNER_NONE, creation_type, &i);
 	(void)ret; // assert only
 	assert(i != nullptr || ret.Failed());
@@ -2476,6 +2675,37 @@ void ClearAllIndustryCachedNames()
 	}
 }
 
+/** Current generation of the industry station candidate lists, never 0. */
+static uint32 _industry_station_candidates_generation = 1;
+
+/**
+ * Mark the station candidate lists of all industries as stale.
+ * This must be called whenever the nearby stations of any industry change,
+ * or the exclusive rights or owner of any station change.
+ */
+void InvalidateAllIndustryStationCandidates()
+{
+	_industry_station_candidates_generation++;
+	if (_industry_station_candidates_generation == 0) _industry_station_candidates_generation = 1;
+}
+
+/**
+ * Get the nearby stations which are not excluded from receiving goods from this industry by exclusive rights.
+ * The list is rebuilt from #stations_near if stale.
+ * @return The candidate stations, in station index order.
+ */
+const std::vector<Station *> &Industry::GetStationCandidates()
+{
+	if (this->station_candidates_generation != _industry_station_candidates_generation) {
+		this->station_candidates.clear();
+		for (Station *st : this->stations_near) {
+			if (!IsStationExcludedFromGoods(st, this->exclusive_consumer)) this->station_candidates.push_back(st);
+		}
+		this->station_candidates_generation = _industry_station_candidates_generation;
+	}
+	return this->station_candidates;
+}
+
 /**
  * Set the #probability and #min_number fields for the industry type \a it for a running game.
  * @param it Industry type.
@@ -3022,6 +3252,7 @@ void IndustryMonthlyLoop()
 void InitializeIndustries()
 {
 	Industry::ResetIndustryCounts();
+	_industry_location_index.Reset();
 	_industry_sound_tile = 0;
 
 	_industry_builder.Reset();
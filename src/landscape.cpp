@@ -29,16 +29,15 @@
 #include "object_base.h"
 #include "company_func.h"
 #include "tunnelbridge_map.h"
-#include "pathfinder/npf/aystar.h"
 #include "saveload/saveload.h"
 #include "framerate_type.h"
 #include "town.h"
-#include "3rdparty/cpp-btree/btree_set.h"
 #include "scope_info.h"
 #include <array>
 #include <list>
 #include <set>
 #include <deque>
+#include <unordered_map>
 
 #include "table/strings.h"
 #include "table/sprites.h"
@@ -586,6 +585,7 @@ void DoClearSquare(TileIndex tile)
 
 	MakeClear(tile, CLEAR_GRASS, _generating_world ? 3 : 0);
 	MarkTileDirtyByTile(tile);
+	UpdateTownGrowthFrontierAroundTile(tile);
 }
 
 /**
@@ -1149,90 +1149,184 @@ static bool FlowsDown(TileIndex begin, TileIndex end)
 			((slopeEnd == slopeBegin && heightEnd < heightBegin) || slopeEnd == SLOPE_FLAT || slopeBegin == SLOPE_FLAT);
 }
 
-/* AyStar callback for checking whether we reached our destination. */
-static int32 River_EndNodeCheck(const AyStar *aystar, const OpenListNode *current)
-{
-	return current->path.node.tile == *(TileIndex*)aystar->user_target ? AYSTAR_FOUND_END_NODE : AYSTAR_DONE;
-}
+/**
+ * Scratch state shared by the river searches of one CreateRivers run,
+ * so that the searches of the individual rivers do not need to allocate their own.
+ */
+struct RiverSearchState {
+	std::vector<uint32> marks;        ///< Per tile, the number of the last flow search which reached the tile.
+	uint32 search = 0;                ///< Number of the current flow search.
+	std::vector<TileIndex> marked;    ///< Tiles reached by the current flow search.
+	std::deque<TileIndex> queue;      ///< Queue of the breadth first flow search.
+	uint rivers = 0;                  ///< Number of river sections built.
+	uint lakes = 0;                   ///< Number of lakes built.
+
+	/** Start a new flow search, such that no tile is marked. */
+	void NewSearch()
+	{
+		if (++this->search == 0) {
+			std::fill(this->marks.begin(), this->marks.end(), 0);
+			this->search = 1;
+		}
+		this->marked.clear();
+		this->queue.clear();
+	}
 
-/* AyStar callback for getting the cost of the current node. */
-static int32 River_CalculateG(AyStar *aystar, AyStarNode *current, OpenListNode *parent)
-{
-	return 1 + RandomRange(_settings_game.game_creation.river_route_random);
-}
+	inline bool IsMarked(TileIndex tile) const { return this->marks[tile] == this->search; }
 
-/* AyStar callback for getting the estimated cost to the destination. */
-static int32 River_CalculateH(AyStar *aystar, AyStarNode *current, OpenListNode *parent)
-{
-	return DistanceManhattan(*(TileIndex*)aystar->user_target, current->tile);
-}
+	inline void Mark(TileIndex tile)
+	{
+		this->marks[tile] = this->search;
+		this->marked.push_back(tile);
+	}
+};
 
-/* AyStar callback for getting the neighbouring nodes of the given node. */
-static void River_GetNeighbours(AyStar *aystar, OpenListNode *current)
-{
-	TileIndex tile = current->path.node.tile;
+static RiverSearchState _river_search;
 
-	aystar->num_neighbours = 0;
-	for (DiagDirection d = DIAGDIR_BEGIN; d < DIAGDIR_END; d++) {
-		TileIndex t2 = tile + TileOffsByDiagDir(d);
-		if (IsValidTile(t2) && FlowsDown(tile, t2)) {
-			aystar->neighbours[aystar->num_neighbours].tile = t2;
-			aystar->neighbours[aystar->num_neighbours].direction = INVALID_TRACKDIR;
-			aystar->num_neighbours++;
-		}
+/**
+ * Open list of the river search: a binary heap which orders items of equal priority exactly like
+ * the BinaryHeap of AyStar, so that the search makes the same random calls and finds the same rivers
+ * as AyStar did for the same seed. Unlike BinaryHeap it keeps the position of each item,
+ * so that an item can be removed without scanning the heap.
+ */
+struct RiverOpenList {
+	static const uint MAX_SIZE = 102400; ///< Capacity of the open list, as used by AyStar; pushes beyond this are dropped.
+
+	struct Item {
+		TileIndex tile;
+		int priority;
+	};
+	std::vector<Item> items;                          ///< Heap, index 0 unused as for BinaryHeap.
+	std::unordered_map<TileIndex, uint> positions;    ///< Heap index of each tile in the heap.
+
+	RiverOpenList() : items(1) {}
+
+	inline uint Size() const { return (uint)this->items.size() - 1; }
+
+	inline void Swap(uint i, uint j)
+	{
+		std::swap(this->items[i], this->items[j]);
+		this->positions[this->items[i].tile] = i;
+		this->positions[this->items[j].tile] = j;
 	}
-}
 
-/* AyStar callback when an route has been found. */
-static void River_FoundEndNode(AyStar *aystar, OpenListNode *current)
-{
-	for (PathNode *path = &current->path; path != nullptr; path = path->parent) {
-		TileIndex tile = path->node.tile;
-		if (!IsWaterTile(tile)) {
-			MakeRiver(tile, Random());
-			MarkTileDirtyByTile(tile);
-			/* Remove desert directly around the river tile. */
-			CircularTileSearch(&tile, _settings_game.game_creation.river_tropics_width, RiverModifyDesertZone, nullptr);
+	/** See BinaryHeap::Push. */
+	bool Push(TileIndex tile, int priority)
+	{
+		if (this->Size() == MAX_SIZE) return false;
+		this->items.push_back({ tile, priority });
+		uint i = this->Size();
+		this->positions[tile] = i;
+		while (i > 1) {
+			uint j = i / 2;
+			if (this->items[i].priority > this->items[j].priority) break;
+			this->Swap(i, j);
+			i = j;
 		}
+		return true;
 	}
-}
 
-static const uint RIVER_HASH_SIZE = 8; ///< The number of bits the hash for river finding should have.
+	/** See BinaryHeap::Delete. */
+	bool Delete(TileIndex tile)
+	{
+		auto it = this->positions.find(tile);
+		if (it == this->positions.end()) return false;
+		uint i = it->second;
+		this->positions.erase(it);
+
+		uint last = this->Size();
+		if (i != last) {
+			this->items[i] = this->items[last];
+			this->positions[this->items[i].tile] = i;
+		}
+		this->items.pop_back();
+		const uint size = this->Size();
+
+		for (;;) {
+			uint j = i;
+			if (2 * j + 1 <= size) {
+				if (this->items[j].priority >= this->items[2 * j].priority) i = 2 * j;
+				if (this->items[i].priority >= this->items[2 * j + 1].priority) i = 2 * j + 1;
+			} else if (2 * j <= size) {
+				if (this->items[j].priority >= this->items[2 * j].priority) i = 2 * j;
+			}
+			if (i == j) break;
+			this->Swap(j, i);
+		}
+		return true;
+	}
 
-/**
- * Simple hash function for river tiles to be used by AyStar.
- * @param tile The tile to hash.
- * @param dir The unused direction.
- * @return The hash for the tile.
- */
-static uint River_Hash(uint tile, uint dir)
-{
-	return GB(TileHash(TileX(tile), TileY(tile)), 0, RIVER_HASH_SIZE);
-}
+	/** See BinaryHeap::Pop. */
+	TileIndex Pop()
+	{
+		TileIndex tile = this->items[1].tile;
+		this->Delete(tile);
+		return tile;
+	}
+};
 
 /**
- * Actually build the river between the begin and end tiles using AyStar.
+ * Actually build the river between the begin and end tiles.
+ * This is an A* search over the tiles the water can flow down to, where each step has a random cost to make the river meander.
+ * It visits the tiles in the same order as the AyStar search it replaces, so the same seed still produces the same rivers.
  * @param begin The begin of the river.
  * @param end The end of the river.
  */
 static void BuildRiver(TileIndex begin, TileIndex end)
 {
-	AyStar finder = {};
-	finder.CalculateG = River_CalculateG;
-	finder.CalculateH = River_CalculateH;
-	finder.GetNeighbours = River_GetNeighbours;
-	finder.EndNodeCheck = River_EndNodeCheck;
-	finder.FoundEndNode = River_FoundEndNode;
-	finder.user_target = &end;
-
-	finder.Init(River_Hash, 1 << RIVER_HASH_SIZE);
-
-	AyStarNode start;
-	start.tile = begin;
-	start.direction = INVALID_TRACKDIR;
-	finder.AddStartNode(&start, 0);
-	finder.Main();
-	finder.Free();
+	struct RiverNode {
+		int cost;         ///< Cost of the best known path from the begin.
+		TileIndex parent; ///< Previous tile of the best known path, or INVALID_TILE for the begin.
+		bool closed;      ///< Whether the best path to this tile is final.
+	};
+	std::unordered_map<TileIndex, RiverNode> nodes;
+	RiverOpenList open;
+
+	nodes[begin] = { 0, INVALID_TILE, false };
+	open.Push(begin, 0);
+
+	while (open.Size() > 0) {
+		TileIndex tile = open.Pop();
+		RiverNode &node = nodes[tile];
+
+		if (tile == end) {
+			for (; tile != INVALID_TILE; tile = nodes[tile].parent) {
+				if (!IsWaterTile(tile)) {
+					MakeRiver(tile, Random());
+					MarkTileDirtyByTile(tile);
+					/* Remove desert directly around the river tile. */
+					TileIndex t = tile;
+					CircularTileSearch(&t, _settings_game.game_creation.river_tropics_width, RiverModifyDesertZone, nullptr);
+				}
+			}
+			_river_search.rivers++;
+			return;
+		}
+
+		node.closed = true;
+
+		for (DiagDirection d = DIAGDIR_BEGIN; d < DIAGDIR_END; d++) {
+			TileIndex t2 = tile + TileOffsByDiagDir(d);
+			if (!IsValidTile(t2) || !FlowsDown(tile, t2)) continue;
+
+			auto it = nodes.find(t2);
+			if (it != nodes.end() && it->second.closed) continue;
+
+			/* Like AyStar, draw the random cost before checking whether this is a better path,
+			 * and take the new path when it is as good as the known one. */
+			int cost = node.cost + 1 + RandomRange(_settings_game.game_creation.river_route_random);
+			int estimate = cost + DistanceManhattan(t2, end);
+			if (it == nodes.end()) {
+				nodes[t2] = { cost, tile, false };
+			} else {
+				if (cost > it->second.cost) continue;
+				open.Delete(t2);
+				it->second.cost = cost;
+				it->second.parent = tile;
+			}
+			open.Push(t2, estimate);
+		}
+	}
 }
 
 /**
@@ -1243,25 +1337,22 @@ static void BuildRiver(TileIndex begin, TileIndex end)
  */
 static bool FlowRiver(TileIndex spring, TileIndex begin)
 {
-#	define SET_MARK(x) marks.insert(x)
-#	define IS_MARKED(x) (marks.find(x) != marks.end())
-
 	uint height = TileHeight(begin);
 	if (IsWaterTile(begin)) return DistanceManhattan(spring, begin) > _settings_game.game_creation.min_river_length;
 
-	btree::btree_set<TileIndex> marks;
-	SET_MARK(begin);
+	RiverSearchState &state = _river_search;
+	state.NewSearch();
+	state.Mark(begin);
 
 	/* Breadth first search for the closest tile we can flow down to. */
-	std::deque<TileIndex> queue;
-	queue.push_back(begin);
+	state.queue.push_back(begin);
 
 	bool found = false;
 	uint count = 0; // Number of tiles considered; to be used for lake location guessing.
 	TileIndex end;
 	do {
-		end = queue.front();
-		queue.pop_front();
+		end = state.queue.front();
+		state.queue.pop_front();
 
 		uint height2 = TileHeight(end);
 		if (IsTileFlat(end) && (height2 < height || (height2 == height && IsWaterTile(end)))) {
@@ -1271,24 +1362,23 @@ static bool FlowRiver(TileIndex spring, TileIndex begin)
 
 		for (DiagDirection d = DIAGDIR_BEGIN; d < DIAGDIR_END; d++) {
 			TileIndex t2 = end + TileOffsByDiagDir(d);
-			if (IsValidTile(t2) && !IS_MARKED(t2) && FlowsDown(end, t2)) {
-				SET_MARK(t2);
+			if (IsValidTile(t2) && !state.IsMarked(t2) && FlowsDown(end, t2)) {
+				state.Mark(t2);
 				count++;
-				queue.push_back(t2);
+				state.queue.push_back(t2);
 			}
 		}
-	} while (!queue.empty());
+	} while (!state.queue.empty());
 
 	if (found) {
 		/* Flow further down hill. */
 		found = FlowRiver(spring, end);
 	} else if (count > 32) {
-		/* Maybe we can make a lake. Find the Nth of the considered tiles. */
+		/* Maybe we can make a lake. Find the Nth of the considered tiles, in tile index order. */
 		TileIndex lakeCenter = 0;
 		int i = RandomRange(count - 1) + 1;
-		btree::btree_set<TileIndex>::const_iterator cit = marks.begin();
-		while (--i) cit++;
-		lakeCenter = *cit;
+		std::nth_element(state.marked.begin(), state.marked.begin() + (i - 1), state.marked.end());
+		lakeCenter = state.marked[i - 1];
 
 		if (IsValidTile(lakeCenter) &&
 				/* A river, or lake, can only be built on flat slopes. */
@@ -1327,11 +1417,11 @@ static bool FlowRiver(TileIndex spring, TileIndex begin)
 			/* Call the search a second time so artefacts from going circular in one direction get (mostly) hidden. */
 			lakeCenter = end;
 			CircularTileSearch(&lakeCenter, range, MakeLake, &data);
+			state.lakes++;
 			found = true;
 		}
 	}
 
-	marks.clear();
 	if (found) BuildRiver(begin, end);
 	return found;
 }
@@ -1347,15 +1437,30 @@ static void CreateRivers()
 	uint wells = ScaleByMapSize(4 << _settings_game.game_creation.amount_of_rivers);
 	SetGeneratingWorldProgress(GWP_RIVER, wells + 256 / 64); // Include the tile loop calls below.
 
+	_river_search.marks.assign(MapSize(), 0);
+	_river_search.search = 0;
+	_river_search.rivers = 0;
+	_river_search.lakes = 0;
+
+	uint springs = 0;
 	for (; wells != 0; wells--) {
 		IncreaseGeneratingWorldProgress(GWP_RIVER);
 		for (int tries = 0; tries < 128; tries++) {
 			TileIndex t = RandomTile();
 			if (!CircularTileSearch(&t, 8, FindSpring, nullptr)) continue;
-			if (FlowRiver(t, t)) break;
+			if (FlowRiver(t, t)) {
+				springs++;
+				break;
+			}
 		}
 	}
 
+	DEBUG(map, 1, "Generated rivers from %u springs: %u river sections, %u lakes", springs, _river_search.rivers, _river_search.lakes);
+
+	_river_search.marks = std::vector<uint32>();
+	_river_search.marked = std::vector<TileIndex>();
+	_river_search.queue = std::deque<TileIndex>();
+
 	/* Run tile loop to update the ground density. */
 	for (uint i = 0; i != 256; i++) {
 		if (i % 64 == 0) IncreaseGeneratingWorldProgress(GWP_RIVER);
@@ -10,6 +10,7 @@
 #include "../stdafx.h"
 #include "../core/pool_func.hpp"
 #include "linkgraph.h"
+#include "../memory_accounting.h"
 
 #include "../safeguards.h"
 
@@ -17,6 +18,15 @@
 LinkGraphPool _link_graph_pool("LinkGraph");
 INSTANTIATE_POOL_METHODS(LinkGraph)
 
+static MemoryAccountingRegistration _link_graph_memory_accounting("LinkGraph nodes and edges", []() -> MemoryAccountingSample {
+	MemoryAccountingSample sample = { 0, 0 };
+	for (const LinkGraph *lg : LinkGraph::Iterate()) {
+		sample.bytes += lg->GetAllocatedMemory();
+		sample.count += lg->Size();
+	}
+	return sample;
+});
+
 /**
  * Create a node or clear it.
  * @param xy Location of the associated station.
@@ -498,6 +498,12 @@ public:
 	 */
 	inline uint Size() const { return (uint)this->nodes.size(); }
 
+	/**
+	 * Get the memory allocated for the nodes and edges of the component.
+	 * @return Size in bytes.
+	 */
+	inline size_t GetAllocatedMemory() const { return this->nodes.capacity() * sizeof(BaseNode) + (size_t)this->edges.Capacity() * sizeof(BaseEdge); }
+
 	/**
 	 * Get date of last compression.
 	 * @return Date of last compression.
@@ -12,6 +12,7 @@
 #include "../window_func.h"
 #include "linkgraphjob.h"
 #include "linkgraphschedule.h"
+#include "../memory_accounting.h"
 
 #include "../safeguards.h"
 
@@ -19,6 +20,15 @@
 LinkGraphJobPool _link_graph_job_pool("LinkGraphJob");
 INSTANTIATE_POOL_METHODS(LinkGraphJob)
 
+static MemoryAccountingRegistration _link_graph_job_memory_accounting("LinkGraphJob nodes and edges", []() -> MemoryAccountingSample {
+	MemoryAccountingSample sample = { 0, 0 };
+	for (const LinkGraphJob *job : LinkGraphJob::Iterate()) {
+		sample.bytes += job->GetAllocatedMemory();
+		sample.count += job->Size();
+	}
+	return sample;
+});
+
 /**
  * Static instance of an invalid path.
  * Note: This instance is created on task start.
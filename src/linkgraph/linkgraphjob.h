@@ -366,6 +366,24 @@ public:
 	 */
 	inline uint Size() const { return this->link_graph.Size(); }
 
+	/**
+	 * Get the memory used by the copy of the link graph and by the annotations of the job.
+	 * The annotations are estimated from the size while the job's thread may still be filling them in,
+	 * the planned flows are only counted once the job has completed.
+	 * @return Size in bytes.
+	 */
+	inline size_t GetAllocatedMemory() const
+	{
+		const size_t size = this->Size();
+		size_t bytes = this->link_graph.GetAllocatedMemory() + size * sizeof(NodeAnnotation) + size * size * sizeof(EdgeAnnotation);
+		if (this->IsJobCompleted()) {
+			for (const NodeAnnotation &anno : this->nodes) {
+				bytes += anno.flows.GetAllocatedMemory();
+			}
+		}
+		return bytes;
+	}
+
 	/**
 	 * Get the cargo of the underlying link graph.
 	 * @return Cargo.
@@ -12,11 +12,75 @@
 #include "../station_func.h"
 #include "../engine_base.h"
 #include "../vehicle_func.h"
+#include "../string_func.h"
 #include "refresh.h"
 #include "linkgraph.h"
 
+#include <set>
+
 #include "../safeguards.h"
 
+/**
+ * Inputs of a link refresher run, for runs which do not depend on anything else.
+ * Two such runs with equal inputs within the same batch refresh exactly the same links with the same capacities,
+ * so only the first needs to be performed.
+ */
+struct LinkRefreshRunKey {
+	OrderListID order_list;        ///< Order list of the vehicle.
+	VehicleOrderID start;          ///< Implicit order index at which the run starts.
+	CargoTypes cargo_mask;         ///< Mask of cargoes to refresh.
+	CargoTypes have_cargo_mask;    ///< Mask of cargoes which the vehicle could leave its last loading station with, within cargo_mask.
+	bool allow_merge;              ///< If the refresher is allowed to merge or extend link graphs.
+	std::vector<uint> capacities;  ///< Capacity of the consist, per cargo ID.
+
+	bool operator<(const LinkRefreshRunKey &other) const
+	{
+		if (this->order_list != other.order_list) return this->order_list < other.order_list;
+		if (this->start != other.start) return this->start < other.start;
+		if (this->cargo_mask != other.cargo_mask) return this->cargo_mask < other.cargo_mask;
+		if (this->have_cargo_mask != other.have_cargo_mask) return this->have_cargo_mask < other.have_cargo_mask;
+		if (this->allow_merge != other.allow_merge) return this->allow_merge < other.allow_merge;
+		return this->capacities < other.capacities;
+	}
+};
+
+static std::set<LinkRefreshRunKey> _link_refresh_batch_runs; ///< Runs already performed in the current batch
+static uint _link_refresh_batch_level = 0;                   ///< Batching is active when non-zero
+LinkRefreshStats _link_refresh_stats;
+
+/**
+ * Check whether a link refresher run for the given vehicle is equivalent to one already performed in the current batch,
+ * and if not, record it as performed.
+ * Runs are only considered if they do not depend on the vehicle beyond its order list, position in it and capacities.
+ * That excludes full loading vehicles and order lists with refit orders.
+ * @param v Vehicle to refresh links for.
+ * @param allow_merge If the refresher is allowed to merge or extend link graphs.
+ * @param is_full_loading If the vehicle is full loading.
+ * @param cargo_mask Mask of cargoes to refresh
+ * @return True if the run can be skipped.
+ */
+static bool IsDuplicateBatchedLinkRefresh(const Vehicle *v, bool allow_merge, bool is_full_loading, CargoTypes cargo_mask)
+{
+	if (_link_refresh_batch_level == 0 || is_full_loading) return false;
+
+	for (const Order *o = v->orders.list->GetFirstOrder(); o != nullptr; o = o->next) {
+		if (o->IsRefit()) return false;
+	}
+
+	LinkRefreshRunKey key;
+	key.order_list = v->orders.list->index;
+	key.start = v->cur_implicit_order_index;
+	key.cargo_mask = cargo_mask;
+	key.have_cargo_mask = v->GetLastLoadingStationValidCargoMask() & cargo_mask;
+	key.allow_merge = allow_merge;
+	key.capacities.resize(NUM_CARGO);
+	for (const Vehicle *u = v; u != nullptr; u = u->Next()) {
+		if (u->refit_cap > 0) key.capacities[u->cargo_type] += u->refit_cap;
+	}
+
+	return !_link_refresh_batch_runs.insert(std::move(key)).second;
+}
+
 /**
  * Refresh all links the given vehicle will visit.
  * @param v Vehicle to refresh links for.
@@ -29,6 +93,12 @@
 	/* If there are no orders we can't predict anything.*/
 	if (v->orders.list == nullptr) return;
 
+	_link_refresh_stats.requested++;
+	if (IsDuplicateBatchedLinkRefresh(v, allow_merge, is_full_loading, cargo_mask)) {
+		_link_refresh_stats.deduplicated++;
+		return;
+	}
+
 	CargoTypes have_cargo_mask = v->GetLastLoadingStationValidCargoMask();
 
 	/* Scan orders for cargo-specific load/unload, and run LinkRefresher separately for each set of cargoes where they differ. */
@@ -62,6 +132,48 @@
 	}
 }
 
+/**
+ * Start batching link refresher runs.
+ * Within a batch, runs with identical inputs are only performed once, see IsDuplicateBatchedLinkRefresh.
+ * Batches may be nested.
+ */
+/* static */ void LinkRefresher::BeginBatch()
+{
+	_link_refresh_batch_level++;
+}
+
+/**
+ * End a batch of link refresher runs.
+ */
+/* static */ void LinkRefresher::EndBatch()
+{
+	assert(_link_refresh_batch_level > 0);
+	_link_refresh_batch_level--;
+	if (_link_refresh_batch_level > 0) return;
+
+	_link_refresh_stats.batches++;
+	_link_refresh_batch_runs.clear();
+}
+
+/**
+ * Notify the link refresher that the orders of an order list have changed, or an order list has been created or deleted.
+ * Runs already performed in the current batch no longer have the same inputs as new runs.
+ */
+/* static */ void LinkRefresher::OnOrderListChanged()
+{
+	_link_refresh_batch_runs.clear();
+}
+
+void DumpLinkRefreshStats(char *b, const char *last)
+{
+	const LinkRefreshStats &stats = _link_refresh_stats;
+	b += seprintf(b, last, "Link refresher runs:\n");
+	b += seprintf(b, last, "  Requested:    " OTTD_PRINTF64U "\n", stats.requested);
+	b += seprintf(b, last, "  Performed:    " OTTD_PRINTF64U "\n", stats.requested - stats.deduplicated);
+	b += seprintf(b, last, "  Deduplicated: " OTTD_PRINTF64U "\n", stats.deduplicated);
+	b += seprintf(b, last, "  Batches:      " OTTD_PRINTF64U "\n", stats.batches);
+}
+
 /**
  * Comparison operator to allow hops to be used in a std::set.
  * @param other Other hop to be compared with.
@@ -16,6 +16,15 @@
 #include <vector>
 #include <map>
 
+/** Statistics of link refresher runs */
+struct LinkRefreshStats {
+	uint64 requested = 0;    ///< Number of link refresher runs requested
+	uint64 deduplicated = 0; ///< Number of link refresher runs skipped because an identical run was already performed in the same batch
+	uint64 batches = 0;      ///< Number of batches ended
+};
+
+extern LinkRefreshStats _link_refresh_stats;
+
 /**
  * Utility to refresh links a consist will visit.
  */
@@ -23,6 +32,10 @@ class LinkRefresher {
 public:
 	static void Run(Vehicle *v, bool allow_merge = true, bool is_full_loading = false, CargoTypes cargo_mask = ALL_CARGOTYPES);
 
+	static void BeginBatch();
+	static void EndBatch();
+	static void OnOrderListChanged();
+
 protected:
 	/**
 	 * Various flags about properties of the last examined link that might have
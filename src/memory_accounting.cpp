@@ -0,0 +1,140 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file memory_accounting.cpp Registry of the memory used by pools, caches and other subsystems. */
+
+#include "stdafx.h"
+#include "memory_accounting.h"
+#include "core/math_func.hpp"
+#include "core/pool_type.hpp"
+#include "string_func.h"
+
+#include <algorithm>
+
+#include "safeguards.h"
+
+/** A registered sampling function. */
+struct MemoryAccountingSampler {
+	const MemoryAccountingRegistration *registration; ///< The registration which added this sampler.
+	const char *name;                                 ///< Name of the subsystem.
+	std::function<MemoryAccountingSample()> sample;   ///< Sampling function.
+};
+
+/**
+ * Function used to access the vector of all registered sampling functions.
+ * @return pointer to vector of all samplers
+ */
+static std::vector<MemoryAccountingSampler> &GetMemoryAccountingSamplers()
+{
+	static std::vector<MemoryAccountingSampler> *samplers = new std::vector<MemoryAccountingSampler>();
+	return *samplers;
+}
+
+static std::vector<MemoryAccountingEntry> _memory_accounting; ///< Accounting of all subsystems, as of the last sample.
+
+MemoryAccountingRegistration::MemoryAccountingRegistration(const char *name, std::function<MemoryAccountingSample()> sample)
+{
+	GetMemoryAccountingSamplers().push_back({ this, name, std::move(sample) });
+}
+
+MemoryAccountingRegistration::~MemoryAccountingRegistration()
+{
+	std::vector<MemoryAccountingSampler> &samplers = GetMemoryAccountingSamplers();
+	samplers.erase(std::remove_if(samplers.begin(), samplers.end(), [&](const MemoryAccountingSampler &sampler) {
+		return sampler.registration == this;
+	}), samplers.end());
+}
+
+/**
+ * Update the accounting entry of a subsystem with a new sample.
+ * @param name Name of the subsystem.
+ * @param bytes Live bytes.
+ * @param count Number of live objects.
+ * @param peak_count Highest number of live objects known to the subsystem itself.
+ */
+static void UpdateMemoryAccountingEntry(const char *name, size_t bytes, size_t count, size_t peak_count)
+{
+	auto iter = std::find_if(_memory_accounting.begin(), _memory_accounting.end(), [&](const MemoryAccountingEntry &entry) {
+		return entry.name == name;
+	});
+	if (iter == _memory_accounting.end()) {
+		_memory_accounting.emplace_back();
+		iter = _memory_accounting.end() - 1;
+		iter->name = name;
+	}
+	iter->bytes = bytes;
+	iter->count = count;
+	iter->peak_bytes = std::max(iter->peak_bytes, bytes);
+	iter->peak_count = std::max({ iter->peak_count, count, peak_count });
+}
+
+/**
+ * Sample all pools and registered subsystems.
+ * Only to be called from the main thread.
+ */
+void UpdateMemoryAccounting()
+{
+	for (const PoolBase *pool : *PoolBase::GetPools()) {
+		PoolBase::MemoryUsage usage = pool->GetMemoryUsage();
+		UpdateMemoryAccountingEntry(pool->GetName(), usage.bytes, usage.items, usage.peak_items);
+	}
+	for (const MemoryAccountingSampler &sampler : GetMemoryAccountingSamplers()) {
+		MemoryAccountingSample sample = sampler.sample();
+		UpdateMemoryAccountingEntry(sampler.name, sample.bytes, sample.count, 0);
+	}
+}
+
+/** Forget the peaks, start tracking them again from the current usage. */
+void ResetMemoryAccountingPeaks()
+{
+	for (PoolBase *pool : *PoolBase::GetPools()) {
+		pool->ResetPeakUsage();
+	}
+	for (MemoryAccountingEntry &entry : _memory_accounting) {
+		entry.peak_bytes = 0;
+		entry.peak_count = 0;
+	}
+	UpdateMemoryAccounting();
+}
+
+/**
+ * Get the accounting of all subsystems, as of the last sample.
+ * @return The accounting entries.
+ */
+const std::vector<MemoryAccountingEntry> &GetMemoryAccounting()
+{
+	return _memory_accounting;
+}
+
+/**
+ * Dump the accounting of all subsystems, sampled now.
+ * @param buffer Output buffer.
+ * @param last End of the output buffer.
+ * @return End of the written output.
+ */
+char *DumpMemoryAccounting(char *buffer, const char *last)
+{
+	UpdateMemoryAccounting();
+
+	std::vector<const MemoryAccountingEntry *> entries;
+	size_t total_bytes = 0;
+	for (const MemoryAccountingEntry &entry : _memory_accounting) {
+		entries.push_back(&entry);
+		total_bytes += entry.bytes;
+	}
+	std::sort(entries.begin(), entries.end(), [](const MemoryAccountingEntry *a, const MemoryAccountingEntry *b) {
+		return a->bytes > b->bytes;
+	});
+
+	buffer += seprintf(buffer, last, "%-40s %12s %12s %10s %10s\n", "Subsystem", "Live KiB", "Peak KiB", "Objects", "Peak obj.");
+	for (const MemoryAccountingEntry *entry : entries) {
+		buffer += seprintf(buffer, last, "%-40s %12u %12u %10u %10u\n", entry->name.c_str(),
+				(uint)CeilDivT<size_t>(entry->bytes, 1024), (uint)CeilDivT<size_t>(entry->peak_bytes, 1024), (uint)entry->count, (uint)entry->peak_count);
+	}
+	buffer += seprintf(buffer, last, "%-40s %12u\n", "Total", (uint)CeilDivT<size_t>(total_bytes, 1024));
+	return buffer;
+}
@@ -0,0 +1,51 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file memory_accounting.h Registry of the memory used by pools, caches and other subsystems. */
+
+#ifndef MEMORY_ACCOUNTING_H
+#define MEMORY_ACCOUNTING_H
+
+#include <functional>
+#include <string>
+#include <vector>
+
+/** Memory used by a subsystem at the time it was sampled. */
+struct MemoryAccountingSample {
+	size_t bytes;                ///< Live bytes.
+	size_t count;                ///< Number of live objects.
+};
+
+/** Accounting of a single subsystem. */
+struct MemoryAccountingEntry {
+	std::string name;            ///< Name of the subsystem.
+	size_t bytes = 0;            ///< Live bytes at the last sample.
+	size_t count = 0;            ///< Number of live objects at the last sample.
+	size_t peak_bytes = 0;       ///< Highest sampled number of live bytes.
+	size_t peak_count = 0;       ///< Highest number of live objects.
+};
+
+/**
+ * Registers a sampling function of a subsystem with the memory accounting, for the lifetime of the object.
+ * Intended for static objects, in the same way as pools register themselves.
+ * Samples are only taken on the main thread, so the sampling functions
+ * need not be thread safe with respect to other main thread code.
+ */
+struct MemoryAccountingRegistration {
+	MemoryAccountingRegistration(const char *name, std::function<MemoryAccountingSample()> sample);
+	~MemoryAccountingRegistration();
+
+private:
+	MemoryAccountingRegistration(const MemoryAccountingRegistration &other) = delete;
+};
+
+void UpdateMemoryAccounting();
+void ResetMemoryAccountingPeaks();
+const std::vector<MemoryAccountingEntry> &GetMemoryAccounting();
+char *DumpMemoryAccounting(char *buffer, const char *last);
+
+#endif /* MEMORY_ACCOUNTING_H */
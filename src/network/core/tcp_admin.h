@@ -59,6 +59,7 @@ enum PacketAdminType {
 	ADMIN_PACKET_SERVER_GAMESCRIPT,      ///< The server gives the admin information from the GameScript in JSON.
 	ADMIN_PACKET_SERVER_RCON_END,        ///< The server indicates that the remote console command has completed.
 	ADMIN_PACKET_SERVER_PONG,            ///< The server replies to a ping request from the admin.
+	ADMIN_PACKET_SERVER_MEMORY,          ///< The server gives the admin the memory used by pools, caches and scripts.
 
 	INVALID_ADMIN_PACKET = 0xFF,         ///< An invalid marker for admin packets.
 };
@@ -82,6 +83,7 @@ enum AdminUpdateType {
 	ADMIN_UPDATE_CMD_NAMES,       ///< The admin would like a list of all DoCommand names.
 	ADMIN_UPDATE_CMD_LOGGING,     ///< The admin would like to have DoCommand information.
 	ADMIN_UPDATE_GAMESCRIPT,      ///< The admin would like to have gamescript messages.
+	ADMIN_UPDATE_MEMORY,          ///< The admin would like to have the memory usage of pools, caches and scripts.
 	ADMIN_UPDATE_END,             ///< Must ALWAYS be on the end of this list!! (period)
 };
 
@@ -477,6 +479,25 @@ protected:
 	 */
 	virtual NetworkRecvStatus Receive_SERVER_RCON_END(Packet *p);
 
+	/**
+	 * Send the memory used by pools, caches and scripts, per subsystem.
+	 *
+	 * NOTICE: Data provided with this packet is not stable and will not be
+	 *         treated as such. Do not rely on names to be constant
+	 *         across different versions / revisions of OpenTTD.
+	 *
+	 * These six fields are repeated until the packet is full:
+	 * bool    Data to follow.
+	 * string  Name of the subsystem.
+	 * uint64  Live bytes.
+	 * uint64  Peak bytes.
+	 * uint64  Live objects.
+	 * uint64  Peak objects.
+	 * @param p The packet that was just received.
+	 * @return The state the network should have.
+	 */
+	virtual NetworkRecvStatus Receive_SERVER_MEMORY(Packet *p);
+
 	NetworkRecvStatus HandlePacket(Packet *p);
 public:
 	NetworkRecvStatus CloseConnection(bool error = true) override;
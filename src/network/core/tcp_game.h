@@ -125,6 +125,8 @@ enum PacketGameType {
 	PACKET_CLIENT_DESYNC_LOG,            ///< A client reports a desync log
 	PACKET_SERVER_DESYNC_LOG,            ///< A server reports a desync log
 	PACKET_CLIENT_DESYNC_MSG,            ///< A client reports a desync message
+	PACKET_CLIENT_STATE_CHECKSUMS,       ///< A client reports its state checksums
+	PACKET_SERVER_STATE_CHECKSUM,        ///< Server tells the client its root state checksum of a frame
 
 	PACKET_END,                          ///< Must ALWAYS be on the end of this list!! (period)
 };
@@ -452,6 +454,24 @@ protected:
 	virtual NetworkRecvStatus Receive_SERVER_DESYNC_LOG(Packet *p);
 	virtual NetworkRecvStatus Receive_CLIENT_DESYNC_MSG(Packet *p);
 
+	/**
+	 * The client reports its state checksums, calculated on a desync or on request of the server:
+	 * uint32  Date of the tick the checksums were calculated at.
+	 * uint16  Date fraction of that tick.
+	 * uint8   Tick skip counter of that tick.
+	 * uint64  Checksums, StateChecksumTree::NODE_COUNT times.
+	 * @param p The packet that was just received.
+	 */
+	virtual NetworkRecvStatus Receive_CLIENT_STATE_CHECKSUMS(Packet *p);
+
+	/**
+	 * Sends the root state checksum of a frame, for the client to check at that frame:
+	 * uint32  Frame counter of the frame.
+	 * uint64  Root of the state checksum tree at the end of that frame.
+	 * @param p The packet that was just received.
+	 */
+	virtual NetworkRecvStatus Receive_SERVER_STATE_CHECKSUM(Packet *p);
+
 	/**
 	 * Notification that a client left the game:
 	 * uint32  ID of the client.
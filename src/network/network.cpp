@@ -69,6 +69,7 @@ uint32 _frame_counter_server;         ///< The frame_counter of the server, if i
 uint32 _frame_counter_max;            ///< To where we may go with our clients
 uint32 _frame_counter;                ///< The current frame.
 uint32 _last_sync_frame;              ///< Used in the server to store the last time a sync packet was sent to clients.
+uint32 _last_state_checksum_frame;    ///< Used in the server to store the last time the root state checksum was sent to clients.
 NetworkAddressList _broadcast_list;   ///< List of broadcast addresses.
 uint32 _sync_seed_1;                  ///< Seed to compare during sync checks.
 #ifdef NETWORK_SEND_DOUBLE_SEED
@@ -815,6 +816,7 @@ bool NetworkServerStart()
 	_frame_counter_server = 0;
 	_frame_counter_max = 0;
 	_last_sync_frame = 0;
+	_last_state_checksum_frame = 0;
 	_network_own_client_id = CLIENT_ID_SERVER;
 
 	_network_clients_connected = 0;
@@ -22,4 +22,14 @@ extern bool _network_dedicated;  ///< are we a dedicated server?
 extern bool _is_network_server;  ///< Does this client wants to be a network-server?
 extern bool _network_settings_access;  ///< Can this client change server settings?
 
+/**
+ * Check whether presentation-only work, which has no effect on the game state, is skipped.
+ * This is the case for dedicated servers, which have no screen.
+ * @return true if there is no screen to present the game on
+ */
+inline bool IsHeadless()
+{
+	return _network_dedicated;
+}
+
 #endif /* NETWORK_H */
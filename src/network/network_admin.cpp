@@ -20,6 +20,7 @@
 #include "../map_func.h"
 #include "../rev.h"
 #include "../game/game.hpp"
+#include "../memory_accounting.h"
 
 #include "../safeguards.h"
 
@@ -52,6 +53,7 @@ static const AdminUpdateFrequency _admin_update_type_frequencies[] = {
 	ADMIN_FREQUENCY_POLL,                                                                                                                                  ///< ADMIN_UPDATE_CMD_NAMES
 	                       ADMIN_FREQUENCY_AUTOMATIC,                                                                                                      ///< ADMIN_UPDATE_CMD_LOGGING
 	                       ADMIN_FREQUENCY_AUTOMATIC,                                                                                                      ///< ADMIN_UPDATE_GAMESCRIPT
+	ADMIN_FREQUENCY_POLL | ADMIN_FREQUENCY_DAILY | ADMIN_FREQUENCY_WEEKLY | ADMIN_FREQUENCY_MONTHLY | ADMIN_FREQUENCY_QUARTERLY | ADMIN_FREQUENCY_ANUALLY, ///< ADMIN_UPDATE_MEMORY
 };
 /** Sanity check. */
 static_assert(lengthof(_admin_update_type_frequencies) == ADMIN_UPDATE_END);
@@ -632,6 +634,37 @@ NetworkRecvStatus ServerNetworkAdminSocketHandler::SendCmdNames()
 	return NETWORK_RECV_STATUS_OKAY;
 }
 
+/** Send the memory used by pools, caches and scripts, as of the last sample. */
+NetworkRecvStatus ServerNetworkAdminSocketHandler::SendMemory()
+{
+	Packet *p = new Packet(ADMIN_PACKET_SERVER_MEMORY);
+
+	for (const MemoryAccountingEntry &entry : GetMemoryAccounting()) {
+		/* Should COMPAT_MTU be exceeded, start a new packet
+		 * (magic 35: 1 bool "more data", four uint64 values, one
+		 * byte for string '\0' termination and 1 bool "no more data" */
+		if (!p->CanWriteToPacket(entry.name.size() + 35)) {
+			p->Send_bool(false);
+			this->SendPacket(p);
+
+			p = new Packet(ADMIN_PACKET_SERVER_MEMORY);
+		}
+
+		p->Send_bool(true);
+		p->Send_string(entry.name.c_str());
+		p->Send_uint64(entry.bytes);
+		p->Send_uint64(entry.peak_bytes);
+		p->Send_uint64(entry.count);
+		p->Send_uint64(entry.peak_count);
+	}
+
+	/* Marker to notify the end of the packet has been reached. */
+	p->Send_bool(false);
+	this->SendPacket(p);
+
+	return NETWORK_RECV_STATUS_OKAY;
+}
+
 /**
  * Send a command for logging purposes.
  * @param client_id The client executing the command.
@@ -768,6 +801,12 @@ NetworkRecvStatus ServerNetworkAdminSocketHandler::Receive_ADMIN_POLL(Packet *p)
 			this->SendCmdNames();
 			break;
 
+		case ADMIN_UPDATE_MEMORY:
+			/* The admin is requesting the memory usage. */
+			UpdateMemoryAccounting();
+			this->SendMemory();
+			break;
+
 		default:
 			/* An unsupported "poll" update type. */
 			DEBUG(net, 3, "[admin] Not supported poll %d (%d) from '%s' (%s).", type, d1, this->admin_name, this->admin_version);
@@ -1016,6 +1055,10 @@ void NetworkAdminUpdate(AdminUpdateFrequency freq)
 						as->SendCompanyStats();
 						break;
 
+					case ADMIN_UPDATE_MEMORY:
+						as->SendMemory();
+						break;
+
 					default: NOT_REACHED();
 				}
 			}
@@ -33,6 +33,7 @@
 #include "../core/checksum_func.hpp"
 #include "../fileio_func.h"
 #include "../debug_settings.h"
+#include "../state_checksum.h"
 
 #include "table/strings.h"
 
@@ -307,13 +308,37 @@ void ClientNetworkGameSocketHandler::ClientError(NetworkRecvStatus res)
 	extern void StateGameLoop();
 	StateGameLoop();
 
+	/* Check the state checksum tree, which covers more than the sync seeds, but is only sent every so often */
+	bool state_checksums_mismatch = false;
+	if (my_client->state_checksum_frame != 0) {
+		if (my_client->state_checksum_frame == _frame_counter) {
+			my_client->last_state_checksums.Calculate();
+			my_client->last_state_checksums_valid = true;
+			state_checksums_mismatch = (my_client->last_state_checksums.root != my_client->state_checksum_root);
+			my_client->state_checksum_frame = 0;
+
+			/* Make sure that the mismatch is handled by the sync check below */
+			if (state_checksums_mismatch && _sync_frame != _frame_counter) {
+				_sync_frame = _frame_counter;
+				_sync_seed_1 = _random.state[0];
+#ifdef NETWORK_SEND_DOUBLE_SEED
+				_sync_seed_2 = _random.state[1];
+#endif
+				_sync_state_checksum = _state_checksum.state;
+			}
+		} else if (my_client->state_checksum_frame < _frame_counter) {
+			DEBUG(net, 1, "Missed frame for state checksum test (%d / %d)", my_client->state_checksum_frame, _frame_counter);
+			my_client->state_checksum_frame = 0;
+		}
+	}
+
 	/* Check if we are in sync! */
 	if (_sync_frame != 0) {
 		if (_sync_frame == _frame_counter) {
 #ifdef NETWORK_SEND_DOUBLE_SEED
-			if (_sync_seed_1 != _random.state[0] || _sync_seed_2 != _random.state[1] || (_sync_state_checksum != _state_checksum.state && !HasChickenBit(DCBF_MP_NO_STATE_CSUM_CHECK))) {
+			if (_sync_seed_1 != _random.state[0] || _sync_seed_2 != _random.state[1] || (_sync_state_checksum != _state_checksum.state && !HasChickenBit(DCBF_MP_NO_STATE_CSUM_CHECK)) || state_checksums_mismatch) {
 #else
-			if (_sync_seed_1 != _random.state[0] || (_sync_state_checksum != _state_checksum.state && !HasChickenBit(DCBF_MP_NO_STATE_CSUM_CHECK))) {
+			if (_sync_seed_1 != _random.state[0] || (_sync_state_checksum != _state_checksum.state && !HasChickenBit(DCBF_MP_NO_STATE_CSUM_CHECK)) || state_checksums_mismatch) {
 #endif
 				DesyncExtraInfo info;
 				if (_sync_seed_1 != _random.state[0]) info.flags |= DesyncExtraInfo::DEIF_RAND1;
@@ -322,12 +347,17 @@ void ClientNetworkGameSocketHandler::ClientError(NetworkRecvStatus res)
 				info.flags |= DesyncExtraInfo::DEIF_DBL_RAND;
 #endif
 				if (_sync_state_checksum != _state_checksum.state) info.flags |= DesyncExtraInfo::DEIF_STATE;
+				if (state_checksums_mismatch) info.flags |= DesyncExtraInfo::DEIF_STATE_TREE;
 
 				NetworkError(STR_NETWORK_ERROR_DESYNC);
 				DEBUG(desync, 1, "sync_err: date{%08x; %02x; %02x} {%x, " OTTD_PRINTFHEX64 "} != {%x, " OTTD_PRINTFHEX64 "}"
 						, _date, _date_fract, _tick_skip_counter, _sync_seed_1, _sync_state_checksum, _random.state[0], _state_checksum.state);
 				DEBUG(net, 0, "Sync error detected!");
 
+				/* Report the state checksums of the last frame they were checked at, the server compares them against those it recorded for that frame.
+				 * When that is the failing frame this localises the desync, otherwise it tells whether the state already differed at that earlier frame. */
+				if (my_client->last_state_checksums_valid) my_client->SendStateChecksums(my_client->last_state_checksums);
+
 				std::string desync_log;
 				info.log_file = &(my_client->desync_log_file);
 				CrashLog::DesyncCrashLog(nullptr, &desync_log, info);
@@ -586,6 +616,23 @@ NetworkRecvStatus ClientNetworkGameSocketHandler::SendDesyncMessage(const char *
 	return NETWORK_RECV_STATUS_OKAY;
 }
 
+/**
+ * Send state checksums, calculated on a desync or on request of the server.
+ * @param tree The checksums.
+ */
+NetworkRecvStatus ClientNetworkGameSocketHandler::SendStateChecksums(const StateChecksumTree &tree)
+{
+	Packet *p = new Packet(PACKET_CLIENT_STATE_CHECKSUMS, SHRT_MAX);
+	p->Send_uint32(tree.date);
+	p->Send_uint16(tree.date_fract);
+	p->Send_uint8(tree.tick_skip_counter);
+	for (uint i = 0; i < StateChecksumTree::NODE_COUNT; i++) {
+		p->Send_uint64(tree.GetNode(i));
+	}
+	my_client->SendPacket(p);
+	return NETWORK_RECV_STATUS_OKAY;
+}
+
 /**
  * Tell the server that we like to change the password of the company.
  * @param password The new password.
@@ -1091,6 +1138,17 @@ NetworkRecvStatus ClientNetworkGameSocketHandler::Receive_SERVER_SYNC(Packet *p)
 	return NETWORK_RECV_STATUS_OKAY;
 }
 
+NetworkRecvStatus ClientNetworkGameSocketHandler::Receive_SERVER_STATE_CHECKSUM(Packet *p)
+{
+	if (this->status == STATUS_CLOSING) return NETWORK_RECV_STATUS_OKAY;
+	if (this->status != STATUS_ACTIVE) return NETWORK_RECV_STATUS_MALFORMED_PACKET;
+
+	this->state_checksum_frame = p->Recv_uint32();
+	this->state_checksum_root = p->Recv_uint64();
+
+	return NETWORK_RECV_STATUS_OKAY;
+}
+
 NetworkRecvStatus ClientNetworkGameSocketHandler::Receive_SERVER_COMMAND(Packet *p)
 {
 	if (this->status == STATUS_CLOSING) return NETWORK_RECV_STATUS_OKAY;
@@ -1545,6 +1603,11 @@ void NetworkClientSendDesyncMsg(const char *msg)
 	MyClient::SendDesyncMessage(msg);
 }
 
+void NetworkClientSendStateChecksums(const StateChecksumTree &tree)
+{
+	MyClient::SendStateChecksums(tree);
+}
+
 /**
  * Set/Reset company password on the client side.
  * @param password Password to be set.
@@ -11,6 +11,7 @@
 #define NETWORK_CLIENT_H
 
 #include "network_internal.h"
+#include "../state_checksum.h"
 
 /** Class for handling the client side of the game connection. */
 class ClientNetworkGameSocketHandler : public NetworkGameSocketHandler {
@@ -40,6 +41,11 @@ private:
 	std::string server_desync_log;
 	bool emergency_save_done = false;
 
+	uint32 state_checksum_frame = 0;               ///< The frame to check the root state checksum at, 0 if none.
+	uint64 state_checksum_root = 0;                ///< The root state checksum of the server at that frame.
+	StateChecksumTree last_state_checksums;        ///< The state checksums of the last frame they were checked at.
+	bool last_state_checksums_valid = false;       ///< Whether last_state_checksums has been calculated.
+
 	static const char *GetServerStatusName(ServerStatus status);
 
 protected:
@@ -64,6 +70,7 @@ protected:
 	NetworkRecvStatus Receive_SERVER_JOIN(Packet *p) override;
 	NetworkRecvStatus Receive_SERVER_FRAME(Packet *p) override;
 	NetworkRecvStatus Receive_SERVER_SYNC(Packet *p) override;
+	NetworkRecvStatus Receive_SERVER_STATE_CHECKSUM(Packet *p) override;
 	NetworkRecvStatus Receive_SERVER_COMMAND(Packet *p) override;
 	NetworkRecvStatus Receive_SERVER_CHAT(Packet *p) override;
 	NetworkRecvStatus Receive_SERVER_QUIT(Packet *p) override;
@@ -97,6 +104,7 @@ public:
 	static NetworkRecvStatus SendError(NetworkErrorCode errorno, NetworkRecvStatus recvstatus = NETWORK_RECV_STATUS_OKAY);
 	static NetworkRecvStatus SendDesyncLog(const std::string &log);
 	static NetworkRecvStatus SendDesyncMessage(const char *msg);
+	static NetworkRecvStatus SendStateChecksums(const struct StateChecksumTree &tree);
 	static NetworkRecvStatus SendQuit();
 	static NetworkRecvStatus SendAck();
 
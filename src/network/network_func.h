@@ -58,6 +58,7 @@ void NetworkClientSendRcon(const char *password, const char *command);
 void NetworkClientSendSettingsPassword(const char *password);
 void NetworkClientSendChat(NetworkAction action, DestType type, int dest, const char *msg, NetworkTextMessageData data = NetworkTextMessageData());
 void NetworkClientSendDesyncMsg(const char *msg);
+void NetworkClientSendStateChecksums(const struct StateChecksumTree &tree);
 bool NetworkClientPreferTeamChat(const NetworkClientInfo *cio);
 bool NetworkCompanyIsPassworded(CompanyID company_id);
 bool NetworkMaxCompaniesReached();
@@ -29,6 +29,7 @@
 #include "../core/random_func.hpp"
 #include "../rev.h"
 #include "../crashlog.h"
+#include "../state_checksum.h"
 #include <mutex>
 #include <condition_variable>
 #if defined(__MINGW32__)
@@ -713,6 +714,19 @@ NetworkRecvStatus ServerNetworkGameSocketHandler::SendSync()
 	return NETWORK_RECV_STATUS_OKAY;
 }
 
+/**
+ * Request the client to check the root of its state checksum tree.
+ * @param root The root of the state checksum tree of the server at the end of the current frame.
+ */
+NetworkRecvStatus ServerNetworkGameSocketHandler::SendStateChecksum(uint64 root)
+{
+	Packet *p = new Packet(PACKET_SERVER_STATE_CHECKSUM, SHRT_MAX);
+	p->Send_uint32(_frame_counter);
+	p->Send_uint64(root);
+	this->SendPacket(p);
+	return NETWORK_RECV_STATUS_OKAY;
+}
+
 /**
  * Send a command to the client to execute.
  * @param cp The command to send.
@@ -1253,6 +1267,52 @@ NetworkRecvStatus ServerNetworkGameSocketHandler::Receive_CLIENT_DESYNC_MSG(Pack
 	return NETWORK_RECV_STATUS_OKAY;
 }
 
+NetworkRecvStatus ServerNetworkGameSocketHandler::Receive_CLIENT_STATE_CHECKSUMS(Packet *p)
+{
+	if (this->status < STATUS_DONE_MAP || this->HasClientQuit()) {
+		/* Illegal call, return error and ignore the packet */
+		return this->SendError(NETWORK_ERROR_NOT_EXPECTED);
+	}
+
+	/* Accept at most one report per client per game day, so that a client can't flood the desync log. */
+	if (this->last_state_checksums_frame != 0 && _frame_counter < this->last_state_checksums_frame + DAY_TICKS) {
+		DEBUG(desync, 1, "Client-id %d state checksums: ignoring report, too soon after the previous one", this->client_id);
+		return NETWORK_RECV_STATUS_OKAY;
+	}
+	this->last_state_checksums_frame = std::max<uint32>(_frame_counter, 1);
+
+	StateChecksumTree tree;
+	tree.date = p->Recv_uint32();
+	tree.date_fract = p->Recv_uint16();
+	tree.tick_skip_counter = p->Recv_uint8();
+	for (uint i = 0; i < StateChecksumTree::NODE_COUNT; i++) {
+		tree.GetNode(i) = p->Recv_uint64();
+	}
+
+	const StateChecksumTree *server_tree = FindRecordedStateChecksumTree(tree);
+	if (server_tree == nullptr) {
+		DEBUG(desync, 1, "Client-id %d state checksums: no server state checksums for date{%08x; %02x; %02x}", this->client_id, tree.date, tree.date_fract, tree.tick_skip_counter);
+		return NETWORK_RECV_STATUS_OKAY;
+	}
+
+	/* Only the first few mismatches go to the desync log, a whole-map desync would otherwise add a line for every map region. */
+	static const uint MAX_LOGGED_MISMATCHES = 16;
+	extern void LogRemoteDesyncMsg(Date date, DateFract date_fract, uint8 tick_skip_counter, uint32 src_id, std::string msg);
+	uint logged = 0;
+	uint mismatches = server_tree->Compare(tree, [&](const char *msg) {
+		DEBUG(desync, 0, "Client-id %d %s", this->client_id, msg);
+		if (logged++ < MAX_LOGGED_MISMATCHES) LogRemoteDesyncMsg(tree.date, tree.date_fract, tree.tick_skip_counter, this->client_id, msg);
+	});
+	if (mismatches > MAX_LOGGED_MISMATCHES) {
+		LogRemoteDesyncMsg(tree.date, tree.date_fract, tree.tick_skip_counter, this->client_id, stdstr_fmt("state checksum mismatch: %u further mismatches not logged", mismatches - MAX_LOGGED_MISMATCHES));
+	}
+	if (mismatches == 0) {
+		DEBUG(desync, 1, "Client-id %d state checksums match", this->client_id);
+		LogRemoteDesyncMsg(tree.date, tree.date_fract, tree.tick_skip_counter, this->client_id, "state checksums match");
+	}
+	return NETWORK_RECV_STATUS_OKAY;
+}
+
 NetworkRecvStatus ServerNetworkGameSocketHandler::Receive_CLIENT_QUIT(Packet *p)
 {
 	/* The client wants to leave. Display this and report it to the other
@@ -1922,6 +1982,16 @@ void NetworkServer_Tick(bool send_frame)
 	}
 #endif
 
+	/* The state checksum tree takes a pass over the whole map, so unlike the sync seeds
+	 * it is not checked every frame, but at most every sync_freq frames and at most once a day. */
+	bool send_state_checksum = false;
+	if (_frame_counter >= _last_state_checksum_frame + std::max<uint>(_settings_client.network.sync_freq, DAY_TICKS)) {
+		_last_state_checksum_frame = _frame_counter;
+		send_state_checksum = true;
+	}
+	StateChecksumTree state_checksums;
+	bool state_checksums_valid = false;
+
 	/* Now we are done with the frame, inform the clients that they can
 	 *  do their frame! */
 	for (NetworkClientSocket *cs : NetworkClientSocket::Iterate()) {
@@ -2041,6 +2111,16 @@ void NetworkServer_Tick(bool send_frame)
 			/* Send a sync-check packet */
 			if (send_sync) cs->SendSync();
 #endif
+
+			if (send_state_checksum) {
+				/* Keep the tree, so that the checksums a client sends when it fails this check can be compared against it. */
+				if (!state_checksums_valid) {
+					state_checksums.Calculate();
+					RecordStateChecksumTree(state_checksums);
+					state_checksums_valid = true;
+				}
+				cs->SendStateChecksum(state_checksums.root);
+			}
 		}
 	}
 
@@ -35,6 +35,7 @@
 #include "guitimer_func.h"
 #include "group_gui.h"
 #include "zoom_func.h"
+#include "network/network.h"
 
 #include "widgets/news_widget.h"
 
@@ -1001,6 +1002,9 @@ void NewsLoop()
 		_last_clean_month = _cur_date_ymd.month;
 	}
 
+	/* Skip showing news on dedicated servers without screen, the news is only kept for the crash log */
+	if (IsHeadless()) return;
+
 	if (ReadyForNextTickerItem()) MoveToNextTickerItem();
 	if (ReadyForNextNewsItem()) MoveToNextNewsItem();
 }
@@ -18,6 +18,7 @@
 #include "autoslope.h"
 #include "clear_func.h"
 #include "water.h"
+#include "station_func.h"
 #include "window_func.h"
 #include "company_gui.h"
 #include "cheat_type.h"
@@ -123,6 +124,7 @@ void BuildObject(ObjectType type, TileIndex tile, CompanyID owner, Town *town, u
 			DirtyCompanyInfrastructureWindows(owner);
 		}
 		MakeObject(t, owner, o->index, wc, Random());
+		AddTileToStationAcceptanceCaches(t);
 		MarkTileDirtyByTile(t, VMDF_NOT_MAP_MODE);
 	}
 
@@ -587,6 +589,7 @@ static void ReallyClearObjectTile(Object *o)
 	Object::DecTypeCount(o->type);
 	TILE_AREA_LOOP(tile_cur, o->location) {
 		DeleteNewGRFInspectWindow(GSF_OBJECTS, tile_cur);
+		RemoveTileFromStationAcceptanceCaches(tile_cur);
 
 		MakeWaterKeepingClass(tile_cur, GetTileOwner(tile_cur));
 	}
@@ -47,6 +47,7 @@
 #include "rev.h"
 #include "highscore.h"
 #include "station_base.h"
+#include "station_func.h"
 #include "crashlog.h"
 #include "engine_func.h"
 #include "core/random_func.hpp"
@@ -60,7 +61,9 @@
 #include "game/game.hpp"
 #include "game/game_config.hpp"
 #include "town.h"
+#include "subsidy_base.h"
 #include "subsidy_func.h"
+#include "economy_func.h"
 #include "gfx_layout.h"
 #include "viewport_func.h"
 #include "viewport_sprite_sorter.h"
@@ -89,6 +92,7 @@
 
 #include <stdarg.h>
 #include <system_error>
+#include <chrono>
 
 #include "safeguards.h"
 
@@ -1337,390 +1341,459 @@ void WriteVehicleInfo(char *&p, const char *last, const Vehicle *u, const Vehicl
 	}
 }
 
-/**
- * Check the validity of some of the caches.
- * Especially in the sense of desyncs between
- * the cached value and what the value would
- * be when calculated from the 'base' data.
- */
-void CheckCaches(bool force_check, std::function<void(const char *)> log)
-{
-	if (!force_check) {
-		/* Return here so it is easy to add checks that are run
-		 * always to aid testing of caches. */
-		if (_debug_desync_level < 1) return;
+/** Output of the cache validity checks. */
+struct CheckCachesLog {
+	std::function<void(const char *)> log; ///< Log function, or nullptr to write to the desync log.
+	char buffer[1024];                     ///< Buffer of the message being output.
 
-		if (_debug_desync_level == 1 && _scaled_date_ticks % 500 != 0) return;
+	CheckCachesLog(std::function<void(const char *)> log) : log(std::move(log)) {}
+
+	/** Output the message in the buffer. */
+	void Output()
+	{
+		DEBUG(desync, 0, "%s", this->buffer);
+		if (this->log) {
+			this->log(this->buffer);
+		} else {
+			LogDesyncMsg(this->buffer);
+		}
 	}
+};
 
-	char cclog_buffer[1024];
 #define CCLOG(...) { \
-	seprintf(cclog_buffer, lastof(cclog_buffer), __VA_ARGS__); \
-	DEBUG(desync, 0, "%s", cclog_buffer); \
-	if (log) { \
-		log(cclog_buffer); \
-	} else { \
-		LogDesyncMsg(cclog_buffer); \
-	} \
+	seprintf(cclog.buffer, lastof(cclog.buffer), __VA_ARGS__); \
+	cclog.Output(); \
 }
 
-	auto output_veh_info = [&](char *&p, const Vehicle *u, const Vehicle *v, uint length) {
-		WriteVehicleInfo(p, lastof(cclog_buffer), u, v, length);
-	};
-
 #define CCLOGV(...) { \
-	char *p = cclog_buffer + seprintf(cclog_buffer, lastof(cclog_buffer), __VA_ARGS__); \
-	output_veh_info(p, u, v, length); \
-	DEBUG(desync, 0, "%s", cclog_buffer); \
-	if (log) { \
-		log(cclog_buffer); \
-	} else { \
-		LogDesyncMsg(cclog_buffer); \
-	} \
+	char *p = cclog.buffer + seprintf(cclog.buffer, lastof(cclog.buffer), __VA_ARGS__); \
+	WriteVehicleInfo(p, lastof(cclog.buffer), u, v, length); \
+	cclog.Output(); \
 }
 
-	/* Check the town caches. */
-	std::vector<TownCache> old_town_caches;
-	std::vector<StationList> old_town_stations_nears;
-	for (const Town *t : Town::Iterate()) {
-		old_town_caches.push_back(t->cache);
-		old_town_stations_nears.push_back(t->stations_near);
-	}
-
-	std::vector<IndustryList> old_station_industries_nears;
-	std::vector<BitmapTileArea> old_station_catchment_tiles;
-	std::vector<uint> old_station_tiles;
-	for (Station *st : Station::Iterate()) {
-		old_station_industries_nears.push_back(st->industries_near);
-		old_station_catchment_tiles.push_back(st->catchment_tiles);
-		old_station_tiles.push_back(st->station_tiles);
-	}
+/**
+ * Check the population, house and town zone caches of all towns.
+ * The houses are counted into temporaries in a single pass over the map, the live caches are left untouched.
+ */
+static void CheckTownHouseCaches(CheckCachesLog &cclog)
+{
+	struct TownHouseCounts {
+		uint32 num_houses;
+		uint32 population;
+		BuildingCounts<uint16> building_counts;
+	};
+	std::vector<TownHouseCounts> counts(Town::GetPoolSize());
+	MemSetT(counts.data(), 0, counts.size());
 
-	std::vector<StationList> old_industry_stations_nears;
-	for (Industry *ind : Industry::Iterate()) {
-		old_industry_stations_nears.push_back(ind->stations_near);
-	}
+	for (TileIndex tile = 0; tile < MapSize(); tile++) {
+		if (!IsTileType(tile, MP_HOUSE)) continue;
 
-	extern void RebuildTownCaches(bool cargo_update_required, bool old_map_position);
-	RebuildTownCaches(false, false);
-	RebuildSubsidisedSourceAndDestinationCache();
+		HouseID house_id = GetHouseType(tile);
+		const HouseSpec *hs = HouseSpec::Get(house_id);
+		TownHouseCounts &c = counts[GetTownIndex(tile)];
+		c.building_counts.id_count[house_id]++;
+		if (hs->class_id != HOUSE_NO_CLASS) c.building_counts.class_count[hs->class_id]++;
+		if (IsHouseCompleted(tile)) c.population += hs->population;
 
-	Station::RecomputeCatchmentForAll();
+		/* Increase the number of houses for every house, but only once. */
+		if (GetHouseNorthPart(house_id) == 0) c.num_houses++;
+	}
 
-	uint i = 0;
-	for (Town *t : Town::Iterate()) {
-		if (MemCmpT(old_town_caches.data() + i, &t->cache) != 0) {
+	for (const Town *t : Town::Iterate()) {
+		const TownHouseCounts &c = counts[t->index];
+		uint32 squared_town_zone_radius[HZB_END];
+		CalculateTownZoneRadius(t, c.num_houses, squared_town_zone_radius);
+		if (c.num_houses != t->cache.num_houses || c.population != t->cache.population ||
+				MemCmpT(&c.building_counts, &t->cache.building_counts) != 0 ||
+				MemCmpT(squared_town_zone_radius, t->cache.squared_town_zone_radius, HZB_END) != 0) {
 			CCLOG("town cache mismatch: town %i", (int)t->index);
 		}
-		if (old_town_stations_nears[i] != t->stations_near) {
-			CCLOG("town stations_near mismatch: town %i, (old size: %u, new size: %u)", (int)t->index, (uint)old_town_stations_nears[i].size(), (uint)t->stations_near.size());
-		}
-		i++;
 	}
-	i = 0;
-	for (Station *st : Station::Iterate()) {
-		if (old_station_industries_nears[i] != st->industries_near) {
-			CCLOG("station industries_near mismatch: st %i, (old size: %u, new size: %u)", (int)st->index, (uint)old_station_industries_nears[i].size(), (uint)st->industries_near.size());
-		}
-		if (!(old_station_catchment_tiles[i] == st->catchment_tiles)) {
-			CCLOG("station catchment_tiles mismatch: st %i", (int)st->index);
-		}
-		if (!(old_station_tiles[i] == st->station_tiles)) {
-			CCLOG("station station_tiles mismatch: st %i, (old: %u, new: %u)", (int)st->index, old_station_tiles[i], st->station_tiles);
+}
+
+/** Check the subsidy, nearby stations and growth caches of a town. */
+static void CheckTownCaches(const Town *t, CheckCachesLog &cclog)
+{
+	PartOfSubsidy part_of_subsidy = POS_NONE;
+	for (const Subsidy *s : Subsidy::Iterate()) {
+		if (s->src_type == ST_TOWN && s->src == t->index) part_of_subsidy |= POS_SRC;
+		if (s->dst_type == ST_TOWN && s->dst == t->index) part_of_subsidy |= POS_DST;
+	}
+	if (part_of_subsidy != t->cache.part_of_subsidy) {
+		CCLOG("town cache mismatch: town %i", (int)t->index);
+	}
+
+	/* Stations whose catchment covers the town but are missing from stations_near are found by CheckStationCaches. */
+	for (const Station *st : t->stations_near) {
+		if (!st->CatchmentCoversTown(t->index)) {
+			CCLOG("town stations_near mismatch: town %i, st %i does not cover the town", (int)t->index, (int)st->index);
 		}
-		i++;
 	}
-	i = 0;
-	for (Industry *ind : Industry::Iterate()) {
-		if (old_industry_stations_nears[i] != ind->stations_near) {
-			CCLOG("industry stations_near mismatch: ind %i, (old size: %u, new size: %u)", (int)ind->index, (uint)old_industry_stations_nears[i].size(), (uint)ind->stations_near.size());
+
+	if ((t->grow_due_tick != 0) != HasBit(t->flags, TOWN_IS_GROWING)) {
+		CCLOG("town growth schedule mismatch: town %i, scheduled: %u, growing: %u", (int)t->index, t->grow_due_tick != 0 ? 1 : 0, HasBit(t->flags, TOWN_IS_GROWING) ? 1 : 0);
+	}
+}
+
+/** Check the nearby stations and station candidates caches of an industry. */
+static void CheckIndustryCaches(Industry *ind, CheckCachesLog &cclog)
+{
+	StationList stlist;
+	if (ind->neutral_station != nullptr && !_settings_game.station.serve_neutral_industries) {
+		stlist.insert(ind->neutral_station);
+		if (ind->stations_near != stlist) {
+			CCLOG("industry neutral station stations_near mismatch: ind %i, (recalc size: %u, neutral size: %u)", (int)ind->index, (uint)ind->stations_near.size(), (uint)stlist.size());
 		}
-		StationList stlist;
-		if (ind->neutral_station != nullptr && !_settings_game.station.serve_neutral_industries) {
-			stlist.insert(ind->neutral_station);
-			if (ind->stations_near != stlist) {
-				CCLOG("industry neutral station stations_near mismatch: ind %i, (recalc size: %u, neutral size: %u)", (int)ind->index, (uint)ind->stations_near.size(), (uint)stlist.size());
-			}
-		} else {
-			ForAllStationsAroundTiles(ind->location, [ind, &stlist](Station *st, TileIndex tile) {
-				if (!IsTileType(tile, MP_INDUSTRY) || GetIndustryIndex(tile) != ind->index) return false;
-				stlist.insert(st);
-				return true;
-			});
-			if (ind->stations_near != stlist) {
-				CCLOG("industry FindStationsAroundTiles mismatch: ind %i, (recalc size: %u, find size: %u)", (int)ind->index, (uint)ind->stations_near.size(), (uint)stlist.size());
-			}
+	} else {
+		ForAllStationsAroundTiles(ind->location, [ind, &stlist](Station *st, TileIndex tile) {
+			if (!IsTileType(tile, MP_INDUSTRY) || GetIndustryIndex(tile) != ind->index) return false;
+			stlist.insert(st);
+			return true;
+		});
+		if (ind->stations_near != stlist) {
+			CCLOG("industry FindStationsAroundTiles mismatch: ind %i, (recalc size: %u, find size: %u)", (int)ind->index, (uint)ind->stations_near.size(), (uint)stlist.size());
 		}
-		i++;
 	}
 
-	/* Check company infrastructure cache. */
-	std::vector<CompanyInfrastructure> old_infrastructure;
-	for (const Company *c : Company::Iterate()) old_infrastructure.push_back(c->infrastructure);
+	std::vector<Station *> station_candidates;
+	for (Station *st : ind->stations_near) {
+		if (!IsStationExcludedFromGoods(st, ind->exclusive_consumer)) station_candidates.push_back(st);
+	}
+	if (station_candidates != ind->GetStationCandidates()) {
+		CCLOG("industry station candidates mismatch: ind %i, (old size: %u, new size: %u)", (int)ind->index, (uint)ind->GetStationCandidates().size(), (uint)station_candidates.size());
+	}
+}
 
-	extern void AfterLoadCompanyStats();
-	AfterLoadCompanyStats();
+/** Check the infrastructure caches of some companies, by recounting them into temporaries in a single pass over the map. */
+static void CheckInfrastructureCaches(CompanyMask companies, CheckCachesLog &cclog)
+{
+	extern void RecountCompanyInfrastructure(CompanyMask companies, CompanyInfrastructure (&infra)[MAX_COMPANIES]);
+	CompanyInfrastructure infrastructure[MAX_COMPANIES];
+	RecountCompanyInfrastructure(companies, infrastructure);
 
-	i = 0;
 	for (const Company *c : Company::Iterate()) {
-		if (MemCmpT(old_infrastructure.data() + i, &c->infrastructure) != 0) {
+		if (!HasBit(companies, c->index)) continue;
+		if (MemCmpT(&infrastructure[c->index], &c->infrastructure) != 0) {
 			CCLOG("infrastructure cache mismatch: company %i", (int)c->index);
 			char buffer[4096];
-			old_infrastructure[i].Dump(buffer, lastof(buffer));
+			c->infrastructure.Dump(buffer, lastof(buffer));
 			CCLOG("Previous:");
 			ProcessLineByLine(buffer, [&](const char *line) {
 				CCLOG("  %s", line);
 			});
-			c->infrastructure.Dump(buffer, lastof(buffer));
+			infrastructure[c->index].Dump(buffer, lastof(buffer));
 			CCLOG("Recalculated:");
 			ProcessLineByLine(buffer, [&](const char *line) {
 				CCLOG("  %s", line);
 			});
 		}
-		i++;
 	}
+}
 
-	/* Strict checking of the road stop cache entries */
-	for (const RoadStop *rs : RoadStop::Iterate()) {
-		if (IsStandardRoadStopTile(rs->xy)) continue;
-
-		assert(rs->GetEntry(DIAGDIR_NE) != rs->GetEntry(DIAGDIR_NW));
-		rs->GetEntry(DIAGDIR_NE)->CheckIntegrity(rs);
-		rs->GetEntry(DIAGDIR_NW)->CheckIntegrity(rs);
-	}
+/** Check the caches of a primary vehicle and its consist. */
+static void CheckPrimaryVehicleCaches(Vehicle *v, CheckCachesLog &cclog)
+{
+	extern void FillNewGRFVehicleCache(const Vehicle *v);
 
-	for (Vehicle *v : Vehicle::Iterate()) {
-		extern bool ValidateVehicleTileHash(const Vehicle *v);
-		if (!ValidateVehicleTileHash(v)) {
-			CCLOG("vehicle tile hash mismatch: type %i, vehicle %i, company %i, unit number %i", (int)v->type, v->index, (int)v->owner, v->unitnumber);
+	uint length = 0;
+	for (const Vehicle *u = v; u != nullptr; u = u->Next()) {
+		if (u->IsGroundVehicle() && (HasBit(u->GetGroundVehicleFlags(), GVF_GOINGUP_BIT) || HasBit(u->GetGroundVehicleFlags(), GVF_GOINGDOWN_BIT)) && u->GetGroundVehicleCache()->cached_slope_resistance && HasBit(v->vcache.cached_veh_flags, VCF_GV_ZERO_SLOPE_RESIST)) {
+			CCLOGV("VCF_GV_ZERO_SLOPE_RESIST set incorrectly (1)");
+		}
+		if (u->type == VEH_TRAIN && u->breakdown_ctr != 0 && !HasBit(Train::From(v)->flags, VRF_CONSIST_BREAKDOWN)) {
+			CCLOGV("VRF_CONSIST_BREAKDOWN incorrectly not set");
+		}
+		if (u->type == VEH_TRAIN && ((Train::From(u)->track & TRACK_BIT_WORMHOLE && !(Train::From(u)->vehstatus & VS_HIDDEN)) || Train::From(u)->track == TRACK_BIT_DEPOT) && !HasBit(Train::From(v)->flags, VRF_CONSIST_SPEED_REDUCTION)) {
+			CCLOGV("VRF_CONSIST_SPEED_REDUCTION incorrectly not set");
 		}
+		length++;
+	}
+
+	NewGRFCache        *grf_cache = CallocT<NewGRFCache>(length);
+	VehicleCache       *veh_cache = CallocT<VehicleCache>(length);
+	GroundVehicleCache *gro_cache = CallocT<GroundVehicleCache>(length);
+	AircraftCache      *air_cache = CallocT<AircraftCache>(length);
+	TrainCache         *tra_cache = CallocT<TrainCache>(length);
+	Vehicle           **veh_old   = CallocT<Vehicle *>(length);
+
+	length = 0;
+	for (const Vehicle *u = v; u != nullptr; u = u->Next()) {
+		FillNewGRFVehicleCache(u);
+		grf_cache[length] = u->grf_cache;
+		veh_cache[length] = u->vcache;
+		switch (u->type) {
+			case VEH_TRAIN:
+				gro_cache[length] = Train::From(u)->gcache;
+				tra_cache[length] = Train::From(u)->tcache;
+				veh_old[length] = CallocT<Train>(1);
+				memcpy((void *) veh_old[length], (const void *) Train::From(u), sizeof(Train));
+				break;
+			case VEH_ROAD:
+				gro_cache[length] = RoadVehicle::From(u)->gcache;
+				veh_old[length] = CallocT<RoadVehicle>(1);
+				memcpy((void *) veh_old[length], (const void *) RoadVehicle::From(u), sizeof(RoadVehicle));
+				break;
+			case VEH_AIRCRAFT:
+				air_cache[length] = Aircraft::From(u)->acache;
+				veh_old[length] = CallocT<Aircraft>(1);
+				memcpy((void *) veh_old[length], (const void *) Aircraft::From(u), sizeof(Aircraft));
+				break;
+			default:
+				veh_old[length] = CallocT<Vehicle>(1);
+				memcpy((void *) veh_old[length], (const void *) u, sizeof(Vehicle));
+				break;
+		}
+		length++;
+	}
 
-		extern void FillNewGRFVehicleCache(const Vehicle *v);
-		if (v != v->First() || v->vehstatus & VS_CRASHED || !v->IsPrimaryVehicle()) continue;
+	switch (v->type) {
+		case VEH_TRAIN:    Train::From(v)->ConsistChanged(CCF_TRACK); break;
+		case VEH_ROAD:     RoadVehUpdateCache(RoadVehicle::From(v)); break;
+		case VEH_AIRCRAFT: UpdateAircraftCache(Aircraft::From(v));   break;
+		case VEH_SHIP:     Ship::From(v)->UpdateCache();             break;
+		default: break;
+	}
 
-		uint length = 0;
-		for (const Vehicle *u = v; u != nullptr; u = u->Next()) {
-			if (u->IsGroundVehicle() && (HasBit(u->GetGroundVehicleFlags(), GVF_GOINGUP_BIT) || HasBit(u->GetGroundVehicleFlags(), GVF_GOINGDOWN_BIT)) && u->GetGroundVehicleCache()->cached_slope_resistance && HasBit(v->vcache.cached_veh_flags, VCF_GV_ZERO_SLOPE_RESIST)) {
-				CCLOGV("VCF_GV_ZERO_SLOPE_RESIST set incorrectly (1)");
-			}
-			if (u->type == VEH_TRAIN && u->breakdown_ctr != 0 && !HasBit(Train::From(v)->flags, VRF_CONSIST_BREAKDOWN)) {
-				CCLOGV("VRF_CONSIST_BREAKDOWN incorrectly not set");
-			}
-			if (u->type == VEH_TRAIN && ((Train::From(u)->track & TRACK_BIT_WORMHOLE && !(Train::From(u)->vehstatus & VS_HIDDEN)) || Train::From(u)->track == TRACK_BIT_DEPOT) && !HasBit(Train::From(v)->flags, VRF_CONSIST_SPEED_REDUCTION)) {
-				CCLOGV("VRF_CONSIST_SPEED_REDUCTION incorrectly not set");
-			}
-			length++;
+	length = 0;
+	for (const Vehicle *u = v; u != nullptr; u = u->Next()) {
+		FillNewGRFVehicleCache(u);
+		if (memcmp(&grf_cache[length], &u->grf_cache, sizeof(NewGRFCache)) != 0) {
+			CCLOGV("newgrf cache mismatch");
 		}
-
-		NewGRFCache        *grf_cache = CallocT<NewGRFCache>(length);
-		VehicleCache       *veh_cache = CallocT<VehicleCache>(length);
-		GroundVehicleCache *gro_cache = CallocT<GroundVehicleCache>(length);
-		AircraftCache      *air_cache = CallocT<AircraftCache>(length);
-		TrainCache         *tra_cache = CallocT<TrainCache>(length);
-		Vehicle           **veh_old   = CallocT<Vehicle *>(length);
-
-		length = 0;
-		for (const Vehicle *u = v; u != nullptr; u = u->Next()) {
-			FillNewGRFVehicleCache(u);
-			grf_cache[length] = u->grf_cache;
-			veh_cache[length] = u->vcache;
-			switch (u->type) {
-				case VEH_TRAIN:
-					gro_cache[length] = Train::From(u)->gcache;
-					tra_cache[length] = Train::From(u)->tcache;
-					veh_old[length] = CallocT<Train>(1);
-					memcpy((void *) veh_old[length], (const void *) Train::From(u), sizeof(Train));
-					break;
-				case VEH_ROAD:
-					gro_cache[length] = RoadVehicle::From(u)->gcache;
-					veh_old[length] = CallocT<RoadVehicle>(1);
-					memcpy((void *) veh_old[length], (const void *) RoadVehicle::From(u), sizeof(RoadVehicle));
-					break;
-				case VEH_AIRCRAFT:
-					air_cache[length] = Aircraft::From(u)->acache;
-					veh_old[length] = CallocT<Aircraft>(1);
-					memcpy((void *) veh_old[length], (const void *) Aircraft::From(u), sizeof(Aircraft));
-					break;
-				default:
-					veh_old[length] = CallocT<Vehicle>(1);
-					memcpy((void *) veh_old[length], (const void *) u, sizeof(Vehicle));
-					break;
-			}
-			length++;
+		if (veh_cache[length].cached_max_speed != u->vcache.cached_max_speed || veh_cache[length].cached_cargo_age_period != u->vcache.cached_cargo_age_period ||
+				veh_cache[length].cached_vis_effect != u->vcache.cached_vis_effect || HasBit(veh_cache[length].cached_veh_flags ^ u->vcache.cached_veh_flags, VCF_LAST_VISUAL_EFFECT)) {
+			CCLOGV("vehicle cache mismatch: %c%c%c%c",
+					veh_cache[length].cached_max_speed != u->vcache.cached_max_speed ? 'm' : '-',
+					veh_cache[length].cached_cargo_age_period != u->vcache.cached_cargo_age_period ? 'c' : '-',
+					veh_cache[length].cached_vis_effect != u->vcache.cached_vis_effect ? 'v' : '-',
+					HasBit(veh_cache[length].cached_veh_flags ^ u->vcache.cached_veh_flags, VCF_LAST_VISUAL_EFFECT) ? 'l' : '-');
 		}
-
-		switch (v->type) {
-			case VEH_TRAIN:    Train::From(v)->ConsistChanged(CCF_TRACK); break;
-			case VEH_ROAD:     RoadVehUpdateCache(RoadVehicle::From(v)); break;
-			case VEH_AIRCRAFT: UpdateAircraftCache(Aircraft::From(v));   break;
-			case VEH_SHIP:     Ship::From(v)->UpdateCache();             break;
-			default: break;
+		if (u->IsGroundVehicle() && (HasBit(u->GetGroundVehicleFlags(), GVF_GOINGUP_BIT) || HasBit(u->GetGroundVehicleFlags(), GVF_GOINGDOWN_BIT)) && u->GetGroundVehicleCache()->cached_slope_resistance && HasBit(v->vcache.cached_veh_flags, VCF_GV_ZERO_SLOPE_RESIST)) {
+			CCLOGV("VCF_GV_ZERO_SLOPE_RESIST set incorrectly (2)");
 		}
-
-		length = 0;
-		for (const Vehicle *u = v; u != nullptr; u = u->Next()) {
-			FillNewGRFVehicleCache(u);
-			if (memcmp(&grf_cache[length], &u->grf_cache, sizeof(NewGRFCache)) != 0) {
-				CCLOGV("newgrf cache mismatch");
-			}
-			if (veh_cache[length].cached_max_speed != u->vcache.cached_max_speed || veh_cache[length].cached_cargo_age_period != u->vcache.cached_cargo_age_period ||
-					veh_cache[length].cached_vis_effect != u->vcache.cached_vis_effect || HasBit(veh_cache[length].cached_veh_flags ^ u->vcache.cached_veh_flags, VCF_LAST_VISUAL_EFFECT)) {
-				CCLOGV("vehicle cache mismatch: %c%c%c%c",
-						veh_cache[length].cached_max_speed != u->vcache.cached_max_speed ? 'm' : '-',
-						veh_cache[length].cached_cargo_age_period != u->vcache.cached_cargo_age_period ? 'c' : '-',
-						veh_cache[length].cached_vis_effect != u->vcache.cached_vis_effect ? 'v' : '-',
-						HasBit(veh_cache[length].cached_veh_flags ^ u->vcache.cached_veh_flags, VCF_LAST_VISUAL_EFFECT) ? 'l' : '-');
-			}
-			if (u->IsGroundVehicle() && (HasBit(u->GetGroundVehicleFlags(), GVF_GOINGUP_BIT) || HasBit(u->GetGroundVehicleFlags(), GVF_GOINGDOWN_BIT)) && u->GetGroundVehicleCache()->cached_slope_resistance && HasBit(v->vcache.cached_veh_flags, VCF_GV_ZERO_SLOPE_RESIST)) {
-				CCLOGV("VCF_GV_ZERO_SLOPE_RESIST set incorrectly (2)");
-			}
-			if (veh_old[length]->acceleration != u->acceleration) {
-				CCLOGV("acceleration mismatch");
-			}
-			if (veh_old[length]->breakdown_chance != u->breakdown_chance) {
-				CCLOGV("breakdown_chance mismatch");
-			}
-			if (veh_old[length]->breakdown_ctr != u->breakdown_ctr) {
-				CCLOGV("breakdown_ctr mismatch");
-			}
-			if (veh_old[length]->breakdown_delay != u->breakdown_delay) {
-				CCLOGV("breakdown_delay mismatch");
-			}
-			if (veh_old[length]->breakdowns_since_last_service != u->breakdowns_since_last_service) {
-				CCLOGV("breakdowns_since_last_service mismatch");
-			}
-			if (veh_old[length]->breakdown_severity != u->breakdown_severity) {
-				CCLOGV("breakdown_severity mismatch");
-			}
-			if (veh_old[length]->breakdown_type != u->breakdown_type) {
-				CCLOGV("breakdown_type mismatch");
-			}
-			if (veh_old[length]->vehicle_flags != u->vehicle_flags) {
-				CCLOGV("vehicle_flags mismatch");
-			}
-			auto print_gv_cache_diff = [&](const char *vtype, const GroundVehicleCache &a, const GroundVehicleCache &b) {
-				CCLOGV("%s ground vehicle cache mismatch: %c%c%c%c%c%c%c%c%c%c",
-						vtype,
-						a.cached_weight != b.cached_weight ? 'w' : '-',
-						a.cached_slope_resistance != b.cached_slope_resistance ? 'r' : '-',
-						a.cached_max_te != b.cached_max_te ? 't' : '-',
-						a.cached_axle_resistance != b.cached_axle_resistance ? 'a' : '-',
-						a.cached_max_track_speed != b.cached_max_track_speed ? 's' : '-',
-						a.cached_power != b.cached_power ? 'p' : '-',
-						a.cached_air_drag != b.cached_air_drag ? 'd' : '-',
-						a.cached_total_length != b.cached_total_length ? 'l' : '-',
-						a.first_engine != b.first_engine ? 'e' : '-',
-						a.cached_veh_length != b.cached_veh_length ? 'L' : '-');
-			};
-			switch (u->type) {
-				case VEH_TRAIN:
-					if (memcmp(&gro_cache[length], &Train::From(u)->gcache, sizeof(GroundVehicleCache)) != 0) {
-						print_gv_cache_diff("train", gro_cache[length], Train::From(u)->gcache);
-					}
-					if (memcmp(&tra_cache[length], &Train::From(u)->tcache, sizeof(TrainCache)) != 0) {
-						CCLOGV("train cache mismatch: %c%c%c%c%c%c%c%c%c",
-								tra_cache[length].cached_override != Train::From(u)->tcache.cached_override ? 'o' : '-',
-								tra_cache[length].cached_tflags != Train::From(u)->tcache.cached_tflags ? 'f' : '-',
-								tra_cache[length].cached_num_engines != Train::From(u)->tcache.cached_num_engines ? 'e' : '-',
-								tra_cache[length].cached_centre_mass != Train::From(u)->tcache.cached_centre_mass ? 'm' : '-',
-								tra_cache[length].cached_veh_weight != Train::From(u)->tcache.cached_veh_weight ? 'w' : '-',
-								tra_cache[length].cached_uncapped_decel != Train::From(u)->tcache.cached_uncapped_decel ? 'D' : '-',
-								tra_cache[length].cached_deceleration != Train::From(u)->tcache.cached_deceleration ? 'd' : '-',
-								tra_cache[length].user_def_data != Train::From(u)->tcache.user_def_data ? 'u' : '-',
-								tra_cache[length].cached_max_curve_speed != Train::From(u)->tcache.cached_max_curve_speed ? 'c' : '-');
-					}
-					if (Train::From(veh_old[length])->railtype != Train::From(u)->railtype) {
-						CCLOGV("railtype mismatch");
-					}
-					if (Train::From(veh_old[length])->compatible_railtypes != Train::From(u)->compatible_railtypes) {
-						CCLOGV("compatible_railtypes mismatch");
-					}
-					if (Train::From(veh_old[length])->flags != Train::From(u)->flags) {
-						CCLOGV("train flags mismatch");
-					}
-					break;
-				case VEH_ROAD:
-					if (memcmp(&gro_cache[length], &RoadVehicle::From(u)->gcache, sizeof(GroundVehicleCache)) != 0) {
-						print_gv_cache_diff("road vehicle", gro_cache[length], Train::From(u)->gcache);
-					}
-					break;
-				case VEH_AIRCRAFT:
-					if (memcmp(&air_cache[length], &Aircraft::From(u)->acache, sizeof(AircraftCache)) != 0) {
-						CCLOGV("Aircraft vehicle cache mismatch: %c%c",
-								air_cache[length].cached_max_range != Aircraft::From(u)->acache.cached_max_range ? 'r' : '-',
-								air_cache[length].cached_max_range_sqr != Aircraft::From(u)->acache.cached_max_range_sqr ? 's' : '-');
-					}
-					break;
-				default:
-					break;
-			}
-			free(veh_old[length]);
-			length++;
+		if (veh_old[length]->acceleration != u->acceleration) {
+			CCLOGV("acceleration mismatch");
 		}
-
-		free(grf_cache);
-		free(veh_cache);
-		free(gro_cache);
-		free(air_cache);
-		free(tra_cache);
-		free(veh_old);
+		if (veh_old[length]->breakdown_chance != u->breakdown_chance) {
+			CCLOGV("breakdown_chance mismatch");
+		}
+		if (veh_old[length]->breakdown_ctr != u->breakdown_ctr) {
+			CCLOGV("breakdown_ctr mismatch");
+		}
+		if (veh_old[length]->breakdown_delay != u->breakdown_delay) {
+			CCLOGV("breakdown_delay mismatch");
+		}
+		if (veh_old[length]->breakdowns_since_last_service != u->breakdowns_since_last_service) {
+			CCLOGV("breakdowns_since_last_service mismatch");
+		}
+		if (veh_old[length]->breakdown_severity != u->breakdown_severity) {
+			CCLOGV("breakdown_severity mismatch");
+		}
+		if (veh_old[length]->breakdown_type != u->breakdown_type) {
+			CCLOGV("breakdown_type mismatch");
+		}
+		if (veh_old[length]->vehicle_flags != u->vehicle_flags) {
+			CCLOGV("vehicle_flags mismatch");
+		}
+		auto print_gv_cache_diff = [&](const char *vtype, const GroundVehicleCache &a, const GroundVehicleCache &b) {
+			CCLOGV("%s ground vehicle cache mismatch: %c%c%c%c%c%c%c%c%c%c",
+					vtype,
+					a.cached_weight != b.cached_weight ? 'w' : '-',
+					a.cached_slope_resistance != b.cached_slope_resistance ? 'r' : '-',
+					a.cached_max_te != b.cached_max_te ? 't' : '-',
+					a.cached_axle_resistance != b.cached_axle_resistance ? 'a' : '-',
+					a.cached_max_track_speed != b.cached_max_track_speed ? 's' : '-',
+					a.cached_power != b.cached_power ? 'p' : '-',
+					a.cached_air_drag != b.cached_air_drag ? 'd' : '-',
+					a.cached_total_length != b.cached_total_length ? 'l' : '-',
+					a.first_engine != b.first_engine ? 'e' : '-',
+					a.cached_veh_length != b.cached_veh_length ? 'L' : '-');
+		};
+		switch (u->type) {
+			case VEH_TRAIN:
+				if (memcmp(&gro_cache[length], &Train::From(u)->gcache, sizeof(GroundVehicleCache)) != 0) {
+					print_gv_cache_diff("train", gro_cache[length], Train::From(u)->gcache);
+				}
+				if (memcmp(&tra_cache[length], &Train::From(u)->tcache, sizeof(TrainCache)) != 0) {
+					CCLOGV("train cache mismatch: %c%c%c%c%c%c%c%c%c",
+							tra_cache[length].cached_override != Train::From(u)->tcache.cached_override ? 'o' : '-',
+							tra_cache[length].cached_tflags != Train::From(u)->tcache.cached_tflags ? 'f' : '-',
+							tra_cache[length].cached_num_engines != Train::From(u)->tcache.cached_num_engines ? 'e' : '-',
+							tra_cache[length].cached_centre_mass != Train::From(u)->tcache.cached_centre_mass ? 'm' : '-',
+							tra_cache[length].cached_veh_weight != Train::From(u)->tcache.cached_veh_weight ? 'w' : '-',
+							tra_cache[length].cached_uncapped_decel != Train::From(u)->tcache.cached_uncapped_decel ? 'D' : '-',
+							tra_cache[length].cached_deceleration != Train::From(u)->tcache.cached_deceleration ? 'd' : '-',
+							tra_cache[length].user_def_data != Train::From(u)->tcache.user_def_data ? 'u' : '-',
+							tra_cache[length].cached_max_curve_speed != Train::From(u)->tcache.cached_max_curve_speed ? 'c' : '-');
+				}
+				if (Train::From(veh_old[length])->railtype != Train::From(u)->railtype) {
+					CCLOGV("railtype mismatch");
+				}
+				if (Train::From(veh_old[length])->compatible_railtypes != Train::From(u)->compatible_railtypes) {
+					CCLOGV("compatible_railtypes mismatch");
+				}
+				if (Train::From(veh_old[length])->flags != Train::From(u)->flags) {
+					CCLOGV("train flags mismatch");
+				}
+				break;
+			case VEH_ROAD:
+				if (memcmp(&gro_cache[length], &RoadVehicle::From(u)->gcache, sizeof(GroundVehicleCache)) != 0) {
+					print_gv_cache_diff("road vehicle", gro_cache[length], Train::From(u)->gcache);
+				}
+				break;
+			case VEH_AIRCRAFT:
+				if (memcmp(&air_cache[length], &Aircraft::From(u)->acache, sizeof(AircraftCache)) != 0) {
+					CCLOGV("Aircraft vehicle cache mismatch: %c%c",
+							air_cache[length].cached_max_range != Aircraft::From(u)->acache.cached_max_range ? 'r' : '-',
+							air_cache[length].cached_max_range_sqr != Aircraft::From(u)->acache.cached_max_range_sqr ? 's' : '-');
+				}
+				break;
+			default:
+				break;
+		}
+		free(veh_old[length]);
+		length++;
 	}
 
-	/* Check whether the caches are still valid */
-	for (Vehicle *v : Vehicle::Iterate()) {
-		byte buff[sizeof(VehicleCargoList)];
-		memcpy(buff, &v->cargo, sizeof(VehicleCargoList));
-		v->cargo.InvalidateCache();
-		assert(memcmp(&v->cargo, buff, sizeof(VehicleCargoList)) == 0);
+	free(grf_cache);
+	free(veh_cache);
+	free(gro_cache);
+	free(air_cache);
+	free(tra_cache);
+	free(veh_old);
+}
+
+/** Check the caches of a single vehicle, and of its consist if it is a primary vehicle. */
+static void CheckVehicleCaches(Vehicle *v, CheckCachesLog &cclog)
+{
+	extern bool ValidateVehicleTileHash(const Vehicle *v);
+	if (!ValidateVehicleTileHash(v)) {
+		CCLOG("vehicle tile hash mismatch: type %i, vehicle %i, company %i, unit number %i", (int)v->type, v->index, (int)v->owner, v->unitnumber);
 	}
 
-	for (Station *st : Station::Iterate()) {
-		for (CargoID c = 0; c < NUM_CARGO; c++) {
-			byte buff[sizeof(StationCargoList)];
-			memcpy(buff, &st->goods[c].cargo, sizeof(StationCargoList));
-			st->goods[c].cargo.InvalidateCache();
-			assert(memcmp(&st->goods[c].cargo, buff, sizeof(StationCargoList)) == 0);
-		}
+	if (v == v->First() && !(v->vehstatus & VS_CRASHED) && v->IsPrimaryVehicle()) CheckPrimaryVehicleCaches(v, cclog);
 
-		/* Check docking tiles */
-		TileArea ta;
-		std::map<TileIndex, bool> docking_tiles;
-		TILE_AREA_LOOP(tile, st->docking_station) {
-			ta.Add(tile);
-			docking_tiles[tile] = IsDockingTile(tile);
+	/* Check whether the cargo list cache is still valid */
+	byte buff[sizeof(VehicleCargoList)];
+	memcpy(buff, &v->cargo, sizeof(VehicleCargoList));
+	v->cargo.InvalidateCache();
+	assert(memcmp(&v->cargo, buff, sizeof(VehicleCargoList)) == 0);
+
+	if (v->Previous()) assert_msg(v->Previous()->Next() == v, "%u", v->index);
+	if (v->Next()) assert_msg(v->Next()->Previous() == v, "%u", v->index);
+}
+
+/** Check the cargo list, docking tile, catchment and acceptance caches of a station. */
+static void CheckStationCaches(Station *st, CheckCachesLog &cclog)
+{
+	for (CargoID c = 0; c < NUM_CARGO; c++) {
+		byte buff[sizeof(StationCargoList)];
+		memcpy(buff, &st->goods[c].cargo, sizeof(StationCargoList));
+		st->goods[c].cargo.InvalidateCache();
+		assert(memcmp(&st->goods[c].cargo, buff, sizeof(StationCargoList)) == 0);
+	}
+
+	/* Check docking tiles */
+	TileArea ta;
+	std::map<TileIndex, bool> docking_tiles;
+	TILE_AREA_LOOP(tile, st->docking_station) {
+		ta.Add(tile);
+		docking_tiles[tile] = IsDockingTile(tile);
+	}
+	UpdateStationDockingTiles(st);
+	if (ta.tile != st->docking_station.tile || ta.w != st->docking_station.w || ta.h != st->docking_station.h) {
+		CCLOG("station docking mismatch: station %i, company %i", st->index, (int)st->owner);
+	}
+	TILE_AREA_LOOP(tile, ta) {
+		if (docking_tiles[tile] != IsDockingTile(tile)) {
+			CCLOG("docking tile mismatch: tile %i", (int)tile);
 		}
-		UpdateStationDockingTiles(st);
-		if (ta.tile != st->docking_station.tile || ta.w != st->docking_station.w || ta.h != st->docking_station.h) {
-			CCLOG("station docking mismatch: station %i, company %i", st->index, (int)st->owner);
+	}
+
+	/* Check the catchment, it is recalculated into temporaries so that the live caches are left untouched. */
+	BitmapTileArea catchment_tiles;
+	uint station_tiles;
+	st->CalculateCatchment(catchment_tiles, station_tiles);
+	if (!(catchment_tiles == st->catchment_tiles)) {
+		CCLOG("station catchment_tiles mismatch: st %i", (int)st->index);
+	}
+	if (!st->rect.IsEmpty() && station_tiles != st->station_tiles) {
+		CCLOG("station station_tiles mismatch: st %i, (old: %u, new: %u)", (int)st->index, st->station_tiles, station_tiles);
+	}
+
+	IndustryList industries_near;
+	if (st->rect.IsEmpty()) {
+		/* Nothing in the catchment. */
+	} else if (!_settings_game.station.serve_neutral_industries && st->industry != nullptr) {
+		industries_near.insert(st->industry);
+	} else {
+		btree::btree_set<TownID> towns_near;
+		BitmapTileIterator it(catchment_tiles);
+		for (TileIndex tile = it; tile != INVALID_TILE; tile = ++it) {
+			if (IsTileType(tile, MP_HOUSE)) towns_near.insert(GetTownIndex(tile));
+			if (IsTileType(tile, MP_INDUSTRY)) {
+				Industry *i = Industry::GetByTile(tile);
+				if (!_settings_game.station.serve_neutral_industries && i->neutral_station != nullptr) continue;
+				if (std::any_of(std::begin(i->accepts_cargo), std::end(i->accepts_cargo), [](CargoID cargo) { return cargo != CT_INVALID; })) {
+					industries_near.insert(i);
+				}
+			}
 		}
-		TILE_AREA_LOOP(tile, ta) {
-			if (docking_tiles[tile] != IsDockingTile(tile)) {
-				CCLOG("docking tile mismatch: tile %i", (int)tile);
+		for (TownID t : towns_near) {
+			if (Town::Get(t)->stations_near.count(st) == 0) {
+				CCLOG("town stations_near mismatch: town %i, st %i covers the town", (int)t, (int)st->index);
 			}
 		}
 	}
+	if (industries_near != st->industries_near) {
+		CCLOG("station industries_near mismatch: st %i, (old size: %u, new size: %u)", (int)st->index, (uint)st->industries_near.size(), (uint)industries_near.size());
+	}
 
-	for (OrderList *order_list : OrderList::Iterate()) {
-		order_list->DebugCheckSanity();
+	if (st->catchment_acceptance_valid) {
+		CargoTypes cached_always_accepted;
+		CargoTypes always_accepted;
+		CargoArray cached_acceptance = GetAcceptanceAroundStation(st, &cached_always_accepted, true);
+		CargoArray acceptance = GetAcceptanceAroundStation(st, &always_accepted, false);
+		if (MemCmpT(&cached_acceptance, &acceptance) != 0 || cached_always_accepted != always_accepted) {
+			CCLOG("station acceptance cache mismatch: st %i", (int)st->index);
+		}
 	}
+}
 
+/** Check the cache entries of a road stop. */
+static void CheckRoadStopCaches(const RoadStop *rs)
+{
+	/* Strict checking of the road stop cache entries */
+	if (IsStandardRoadStopTile(rs->xy)) return;
+
+	assert(rs->GetEntry(DIAGDIR_NE) != rs->GetEntry(DIAGDIR_NW));
+	rs->GetEntry(DIAGDIR_NE)->CheckIntegrity(rs);
+	rs->GetEntry(DIAGDIR_NW)->CheckIntegrity(rs);
+}
+
+/** Check the links of a template vehicle. */
+static void CheckTemplateVehicleCaches(const TemplateVehicle *tv)
+{
+	if (tv->Prev()) assert_msg(tv->Prev()->Next() == tv, "%u", tv->index);
+	if (tv->Next()) assert_msg(tv->Next()->Prev() == tv, "%u", tv->index);
+}
+
+/** Check the remaining caches, which are not tied to a single town, station, company or vehicle. */
+static void CheckMiscCaches(CheckCachesLog &cclog)
+{
 	extern void ValidateVehicleTickCaches();
 	ValidateVehicleTickCaches();
 
-	for (Vehicle *v : Vehicle::Iterate()) {
-		if (v->Previous()) assert_msg(v->Previous()->Next() == v, "%u", v->index);
-		if (v->Next()) assert_msg(v->Next()->Previous() == v, "%u", v->index);
-	}
-	for (const TemplateVehicle *tv : TemplateVehicle::Iterate()) {
-		if (tv->Prev()) assert_msg(tv->Prev()->Next() == tv, "%u", tv->index);
-		if (tv->Next()) assert_msg(tv->Next()->Prev() == tv, "%u", tv->index);
-	}
-
 	if (!TraceRestrictSlot::ValidateVehicleIndex()) CCLOG("Trace restrict slot vehicle index validation failed");
-	TraceRestrictSlot::ValidateSlotOccupants(log);
+	TraceRestrictSlot::ValidateSlotOccupants(cclog.log);
 
 	if (!CargoPacket::ValidateDeferredCargoPayments()) CCLOG("Cargo packets deferred payments validation failed");
 
+	extern bool ValidateIndustryLocationIndex();
+	if (!ValidateIndustryLocationIndex()) {
+		CCLOG("industry location index mismatch");
+	}
+
 	if (_order_destination_refcount_map_valid) {
 		btree::btree_map<uint32, uint32> saved_order_destination_refcount_map = std::move(_order_destination_refcount_map);
 		for (auto iter = saved_order_destination_refcount_map.begin(); iter != saved_order_destination_refcount_map.end();) {
@@ -1735,10 +1808,219 @@ void CheckCaches(bool force_check, std::function<void(const char *)> log)
 	} else {
 		CCLOG("Order destination refcount map not valid");
 	}
+}
+
+/**
+ * Check the validity of some of the caches.
+ * Especially in the sense of desyncs between
+ * the cached value and what the value would
+ * be when calculated from the 'base' data.
+ */
+void CheckCaches(bool force_check, std::function<void(const char *)> log)
+{
+	if (!force_check) {
+		/* Return here so it is easy to add checks that are run
+		 * always to aid testing of caches. */
+		if (_debug_desync_level < 1) return;
+
+		if (_debug_desync_level == 1 && _scaled_date_ticks % 500 != 0) return;
+	}
+
+	CheckCachesLog cclog(std::move(log));
+
+	CheckTownHouseCaches(cclog);
+	for (const Town *t : Town::Iterate()) CheckTownCaches(t, cclog);
+	for (Industry *ind : Industry::Iterate()) CheckIndustryCaches(ind, cclog);
+	CheckInfrastructureCaches(MAX_UVALUE(CompanyMask), cclog);
+	for (Vehicle *v : Vehicle::Iterate()) CheckVehicleCaches(v, cclog);
+	for (Station *st : Station::Iterate()) CheckStationCaches(st, cclog);
+	for (OrderList *order_list : OrderList::Iterate()) order_list->DebugCheckSanity();
+	for (const RoadStop *rs : RoadStop::Iterate()) CheckRoadStopCaches(rs);
+	for (const TemplateVehicle *tv : TemplateVehicle::Iterate()) CheckTemplateVehicleCaches(tv);
+	CheckMiscCaches(cclog);
+}
+
+uint _check_caches_budget = 0; ///< Time budget in microseconds per tick of the incremental cache checks, 0 to disable them.
+
+/** Phases of the incremental cache checks, see CheckCachesIncremental. */
+enum IncrementalCacheCheckPhase {
+	ICCP_VEHICLES,               ///< Vehicles, a budgeted number per tick.
+	ICCP_STATIONS,               ///< Stations, a budgeted number per tick.
+	ICCP_ORDER_LISTS,            ///< Order lists, a budgeted number per tick.
+	ICCP_TOWNS,                  ///< Towns, a budgeted number per tick.
+	ICCP_INDUSTRIES,             ///< Industries, a budgeted number per tick.
+	ICCP_ROAD_STOPS,             ///< Road stops, a budgeted number per tick.
+	ICCP_TEMPLATE_VEHICLES,      ///< Template vehicles, a budgeted number per tick.
+	ICCP_TOWN_HOUSES,            ///< Town house caches, one step of a pass over the map.
+	ICCP_INFRASTRUCTURE,         ///< Company infrastructure caches, one step per company of a pass over the map.
+	ICCP_MISC,                   ///< Remaining caches, in one step.
+	ICCP_END,
+};
+
+/** Progress of the incremental cache checks. */
+static struct {
+	uint phase;                  ///< Current IncrementalCacheCheckPhase.
+	size_t next_index;           ///< Pool index to continue from in the per-object phases.
+	int64 credit;                ///< Unspent time budget in microseconds.
+	int64 step_cost[ICCP_END];   ///< Last measured duration in microseconds of a step of the stepped phases, 0 if not measured yet.
+	Date cycle_start;            ///< Date at which the current cycle started.
+} _incremental_cache_check;
+
+/**
+ * Get the expected duration of a step of a phase of the incremental cache checks.
+ * Until a step has been measured, its duration is estimated pessimistically from the amount of data
+ * it has to go through, so that the first step also waits until enough budget has been saved up.
+ * @param phase IncrementalCacheCheckPhase of the step.
+ * @return Expected duration in microseconds, 0 for the phases which check a budgeted number of objects per tick.
+ */
+static int64 GetIncrementalCacheCheckStepCost(uint phase)
+{
+	if (_incremental_cache_check.step_cost[phase] > 0) return _incremental_cache_check.step_cost[phase];
+
+	switch (phase) {
+		case ICCP_TOWN_HOUSES:
+		case ICCP_INFRASTRUCTURE:
+			return MapSize() / 16;
+
+		case ICCP_MISC:
+			return (Vehicle::GetNumItems() + CargoPacket::GetNumItems() + Order::GetNumItems()) / 16;
+
+		default:
+			return 0;
+	}
+}
+
+/**
+ * Check a rotating subset of the caches, spending about #_check_caches_budget microseconds per tick.
+ * Vehicles, stations, order lists, towns, industries, road stops and template vehicles are checked
+ * a few at a time, continuing by pool index where the previous tick left off.
+ * The checks which need a pass over the map or over a whole pool are run as separate steps, the
+ * company infrastructure one company at a time. A step runs once enough budget has been saved up
+ * to cover its previously measured (or initially estimated) duration.
+ * All checks compare against values recalculated into temporaries, the live caches are not rebuilt.
+ * Mismatches are reported to the desync log, the same as for CheckCaches.
+ */
+void CheckCachesIncremental()
+{
+	if (_check_caches_budget == 0) return;
+
+	auto &state = _incremental_cache_check;
+	const int64 budget = _check_caches_budget;
+	state.credit = std::min<int64>(state.credit + budget, std::max<int64>(budget, GetIncrementalCacheCheckStepCost(state.phase)));
+	if (state.credit <= 0) return;
+
+	const auto start = std::chrono::steady_clock::now();
+	auto elapsed = [&]() -> int64 {
+		return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+	};
+
+	CheckCachesLog cclog(nullptr);
+	bool phase_done = false;
+
+	/* Check objects of a pool from where the last tick stopped, until the pool end or the budget is reached. */
+	auto check_pool = [&](size_t pool_size, auto check) {
+		const int64 allowance = std::min(state.credit, budget);
+		do {
+			if (state.next_index >= pool_size) {
+				phase_done = true;
+				return;
+			}
+			check(state.next_index++);
+		} while (elapsed() < allowance);
+	};
+
+	/* Run a single step if enough budget has been saved up for it, and measure its duration. */
+	auto check_step = [&](auto check) -> bool {
+		if (state.credit < GetIncrementalCacheCheckStepCost(state.phase)) return false;
+		check();
+		state.step_cost[state.phase] = std::max<int64>(1, elapsed());
+		return true;
+	};
+
+	switch (state.phase) {
+		case ICCP_VEHICLES:
+			check_pool(Vehicle::GetPoolSize(), [&](size_t index) {
+				Vehicle *v = Vehicle::GetIfValid(index);
+				if (v != nullptr) CheckVehicleCaches(v, cclog);
+			});
+			break;
+
+		case ICCP_STATIONS:
+			check_pool(Station::GetPoolSize(), [&](size_t index) {
+				Station *st = Station::GetIfValid(index);
+				if (st != nullptr) CheckStationCaches(st, cclog);
+			});
+			break;
+
+		case ICCP_ORDER_LISTS:
+			check_pool(OrderList::GetPoolSize(), [&](size_t index) {
+				OrderList *order_list = OrderList::GetIfValid(index);
+				if (order_list != nullptr) order_list->DebugCheckSanity();
+			});
+			break;
+
+		case ICCP_TOWNS:
+			check_pool(Town::GetPoolSize(), [&](size_t index) {
+				const Town *t = Town::GetIfValid(index);
+				if (t != nullptr) CheckTownCaches(t, cclog);
+			});
+			break;
+
+		case ICCP_INDUSTRIES:
+			check_pool(Industry::GetPoolSize(), [&](size_t index) {
+				Industry *ind = Industry::GetIfValid(index);
+				if (ind != nullptr) CheckIndustryCaches(ind, cclog);
+			});
+			break;
+
+		case ICCP_ROAD_STOPS:
+			check_pool(RoadStop::GetPoolSize(), [&](size_t index) {
+				const RoadStop *rs = RoadStop::GetIfValid(index);
+				if (rs != nullptr) CheckRoadStopCaches(rs);
+			});
+			break;
+
+		case ICCP_TEMPLATE_VEHICLES:
+			check_pool(TemplateVehicle::GetPoolSize(), [&](size_t index) {
+				const TemplateVehicle *tv = TemplateVehicle::GetIfValid(index);
+				if (tv != nullptr) CheckTemplateVehicleCaches(tv);
+			});
+			break;
+
+		case ICCP_TOWN_HOUSES:
+			phase_done = check_step([&]() { CheckTownHouseCaches(cclog); });
+			break;
+
+		case ICCP_INFRASTRUCTURE:
+			while (state.next_index < Company::GetPoolSize() && !Company::IsValidID(state.next_index)) state.next_index++;
+			if (state.next_index >= Company::GetPoolSize()) {
+				phase_done = true;
+				break;
+			}
+			if (check_step([&]() { CheckInfrastructureCaches((CompanyMask)(1 << state.next_index), cclog); })) state.next_index++;
+			break;
+
+		case ICCP_MISC:
+			phase_done = check_step([&]() { CheckMiscCaches(cclog); });
+			break;
+
+		default: NOT_REACHED();
+	}
+
+	state.credit -= elapsed();
+
+	if (phase_done) {
+		state.next_index = 0;
+		if (++state.phase == ICCP_END) {
+			DEBUG(desync, 2, "Incremental cache check cycle complete, started: %d, now: %d", state.cycle_start, _date);
+			state.phase = ICCP_VEHICLES;
+			state.cycle_start = _date;
+		}
+	}
+}
 
 #undef CCLOGV
 #undef CCLOG
-}
 
 /**
  * Network-safe forced desync check.
@@ -1789,7 +2071,8 @@ void StateGameLoop()
 	PerformanceMeasurer framerate(PFE_GAMELOOP);
 	PerformanceAccumulator::Reset(PFE_GL_LANDSCAPE);
 
-	Layouter::ReduceLineCache();
+	/* Skip presentation-only work on dedicated servers without screen */
+	if (!IsHeadless()) Layouter::ReduceLineCache();
 
 	if (_game_mode == GM_EDITOR) {
 		BasePersistentStorageArray::SwitchMode(PSM_ENTER_GAMELOOP);
@@ -1810,6 +2093,7 @@ void StateGameLoop()
 		}
 
 		CheckCaches(false, nullptr);
+		CheckCachesIncremental();
 
 		/* All these actions has to be done from OWNER_NONE
 		 *  for multiplayer compatibility */
@@ -1841,7 +2125,7 @@ void StateGameLoop()
 #endif
 		UpdateLandscapingLimits();
 
-		CallWindowGameTickEvent();
+		if (!IsHeadless()) CallWindowGameTickEvent();
 		NewsLoop();
 		cur_company.Restore();
 
@@ -21,10 +21,11 @@
 #include "schdispatch.h"
 
 #include <memory>
+#include <set>
 #include <vector>
 #include "3rdparty/cpp-btree/btree_map.h"
 
-typedef Pool<Order, OrderID, 256, 0xFF0000> OrderPool;
+typedef Pool<Order, OrderID, 256, 0xFF0000, PT_NORMAL, false, true, true> OrderPool;
 typedef Pool<OrderList, OrderListID, 128, 64000> OrderListPool;
 extern OrderPool _order_pool;
 extern OrderListPool _orderlist_pool;
@@ -585,9 +586,17 @@ private:
 	friend const struct SaveLoad *GetOrderListDescription(); ///< Saving and loading of order lists.
 	friend void Ptrs_ORDL(); ///< Saving and loading of order lists.
 
+	/** Result of skipping over orders which can never be decision nodes, see GetNextDecisionNode. */
+	struct DecisionNodeSkip {
+		const Order *target; ///< First order reached which may be a decision node, or nullptr if there is none within the hop limit.
+		uint16 hops;         ///< Number of orders skipped to reach target.
+	};
+
 	StationID GetBestLoadableNext(const Vehicle *v, const Order *o1, const Order *o2) const;
 	void ReindexOrderList();
 	Order *GetOrderAtFromList(int index) const;
+	DecisionNodeSkip ComputeDecisionNodeSkip(const Order *o) const;
+	DecisionNodeSkip GetDecisionNodeSkip(const Order *o) const;
 
 	Order *first;                     ///< First order of the order list.
 	std::vector<Order *> order_index; ///< NOSAVE: Vector index of order list.
@@ -598,6 +607,8 @@ private:
 	Ticks timetable_duration;         ///< NOSAVE: Total timetabled duration of the order list.
 	Ticks total_duration;             ///< NOSAVE: Total (timetabled or not) duration of the order list.
 
+	mutable btree::btree_map<const Order *, DecisionNodeSkip> decision_node_skips; ///< NOSAVE: Lazily populated cache of decision node skips, by starting order.
+
 	std::vector<uint32> scheduled_dispatch;    ///< Scheduled dispatch time
 	uint32 scheduled_dispatch_duration;        ///< Scheduled dispatch duration
 	Date scheduled_dispatch_start_date;        ///< Scheduled dispatch start date
@@ -667,6 +678,8 @@ public:
 	CargoMaskedStationIDStack GetNextStoppingStation(const Vehicle *v, CargoTypes cargo_mask, const Order *first = nullptr, uint hops = 0) const;
 	const Order *GetNextDecisionNode(const Order *next, uint hops, CargoTypes &cargo_mask) const;
 
+	void InvalidateOrderCaches();
+
 	void InsertOrderAt(Order *new_order, int index);
 	void DeleteOrderAt(int index);
 	void MoveOrder(int from, int to);
@@ -750,6 +763,7 @@ public:
 	void RemoveScheduledDispatch(uint32 offset);
 	void UpdateScheduledDispatch();
 	void ResetScheduledDispatch();
+	DateTicksScaled GetScheduledDispatchNextSlot(DateTicksScaled earliest_exclusive, const std::set<DateTicksScaled> *used_slots = nullptr) const;
 
 	/**
 	 * Set the scheduled dispatch duration, in scaled tick
@@ -37,6 +37,7 @@
 #include "order_cmd.h"
 #include "vehiclelist.h"
 #include "tracerestrict.h"
+#include "linkgraph/refresh.h"
 
 #include "table/strings.h"
 
@@ -402,8 +403,19 @@ void CargoStationIDStackSet::FillNextStoppingStation(const Vehicle *v, const Ord
 	}
 }
 
+/**
+ * Invalidate caches derived from the orders in this list: the cache used by GetNextDecisionNode and the runs of the current link refresher batch.
+ * This must be called whenever an order in the list is added, removed, moved or has its type, flags or conditional target changed.
+ */
+void OrderList::InvalidateOrderCaches()
+{
+	this->decision_node_skips.clear();
+	LinkRefresher::OnOrderListChanged();
+}
+
 void OrderList::ReindexOrderList()
 {
+	this->InvalidateOrderCaches();
 	this->order_index.clear();
 	for (Order *o = this->first; o != nullptr; o = o->next) {
 		this->order_index.push_back(o);
@@ -435,6 +447,7 @@ void OrderList::Initialize(Order *chain, Vehicle *v)
 	this->timetable_duration = 0;
 	this->total_duration = 0;
 	this->order_index.clear();
+	this->InvalidateOrderCaches();
 
 	VehicleType type = v->type;
 	Owner owner = v->owner;
@@ -492,6 +505,7 @@ void OrderList::FreeChain(bool keep_orderlist)
 		this->num_manual_orders = 0;
 		this->timetable_duration = 0;
 		this->order_index.clear();
+		this->InvalidateOrderCaches();
 	} else {
 		delete this;
 	}
@@ -533,9 +547,75 @@ VehicleOrderID OrderList::GetIndexOfOrder(const Order *order) const
 	return INVALID_VEH_ORDER_ID;
 }
 
+/**
+ * Check whether an order may be a decision node for GetNextDecisionNode, for some cargo mask.
+ * Orders for which this returns false are always passed over.
+ * @param o The order to check.
+ * @return true if the order may be a decision node.
+ */
+static bool IsPossibleDecisionNode(const Order *o)
+{
+	switch (o->GetType()) {
+		case OT_CONDITIONAL:
+			return o->GetConditionVariable() != OCV_UNCONDITIONALLY;
+
+		case OT_GOTO_DEPOT:
+			return (o->GetDepotActionType() & ODATFB_HALT) || o->IsRefit();
+
+		case OT_GOTO_STATION:
+		case OT_IMPLICIT:
+			return (o->GetNonStopType() & ONSF_NO_STOP_AT_DESTINATION_STATION) == 0;
+
+		default:
+			return false;
+	}
+}
+
+/**
+ * Follow the orders starting at the given one, until reaching an order which may be a decision node.
+ * @param o The order to start at.
+ * @return The first order which may be a decision node and the number of orders passed over to reach it.
+ *         The target is nullptr if there is no such order within the hop limit of GetNextDecisionNode.
+ */
+OrderList::DecisionNodeSkip OrderList::ComputeDecisionNodeSkip(const Order *o) const
+{
+	const uint limit = std::min<uint>(64, this->GetNumOrders());
+	DecisionNodeSkip result = { o, 0 };
+	while (result.target != nullptr && !IsPossibleDecisionNode(result.target)) {
+		if (result.hops >= limit) {
+			result.target = nullptr;
+			break;
+		}
+		if (result.target->IsType(OT_CONDITIONAL)) {
+			/* Trivial conditional, these are conceptually the same as regular order progression. */
+			result.target = this->GetOrderAt(result.target->GetConditionSkipToOrder());
+		} else {
+			result.target = this->GetNext(result.target);
+		}
+		result.hops++;
+	}
+	return result;
+}
+
+/**
+ * Get the cached result of ComputeDecisionNodeSkip for the given order.
+ * @param o The order to start at.
+ * @return The first order which may be a decision node and the number of orders passed over to reach it.
+ */
+OrderList::DecisionNodeSkip OrderList::GetDecisionNodeSkip(const Order *o) const
+{
+	auto iter = this->decision_node_skips.find(o);
+	if (iter != this->decision_node_skips.end()) return iter->second;
+
+	DecisionNodeSkip result = this->ComputeDecisionNodeSkip(o);
+	this->decision_node_skips.insert({ o, result });
+	return result;
+}
+
 /**
  * Get the next order which will make the given vehicle stop at a station
  * or refit at a depot or evaluate a non-trivial condition.
+ * Runs of orders which are always passed over are skipped using the decision node cache.
  * @param next The order to start looking at.
  * @param hops The number of orders we have already looked at.
  * @param cargo_mask The bit set of cargoes that the we are looking at, this may be reduced to indicate the set of cargoes that the result is valid for. This may be 0 to ignore cargo types entirely.
@@ -547,45 +627,45 @@ VehicleOrderID OrderList::GetIndexOfOrder(const Order *order) const
  */
 const Order *OrderList::GetNextDecisionNode(const Order *next, uint hops, CargoTypes &cargo_mask) const
 {
-	if (hops > std::min<uint>(64, this->GetNumOrders()) || next == nullptr) return nullptr;
+	const uint limit = std::min<uint>(64, this->GetNumOrders());
 
-	if (next->IsType(OT_CONDITIONAL)) {
-		if (next->GetConditionVariable() != OCV_UNCONDITIONALLY) return next;
+	while (hops <= limit && next != nullptr) {
+		DecisionNodeSkip skip = this->GetDecisionNodeSkip(next);
+		next = skip.target;
+		hops += skip.hops;
+		if (hops > limit || next == nullptr) return nullptr;
 
-		/* We can evaluate trivial conditions right away. They're conceptually
-		 * the same as regular order progression. */
-		return this->GetNextDecisionNode(
-				this->GetOrderAt(next->GetConditionSkipToOrder()),
-				hops + 1, cargo_mask);
-	}
+		if (next->IsType(OT_CONDITIONAL)) return next;
 
-	if (next->IsType(OT_GOTO_DEPOT)) {
-		if (next->GetDepotActionType() & ODATFB_HALT) return nullptr;
-		if (next->IsRefit()) return next;
-	}
+		if (next->IsType(OT_GOTO_DEPOT)) {
+			if (next->GetDepotActionType() & ODATFB_HALT) return nullptr;
+			if (next->IsRefit()) return next;
+		}
 
-	bool can_load_or_unload = false;
-	if ((next->IsType(OT_GOTO_STATION) || next->IsType(OT_IMPLICIT)) &&
-			(next->GetNonStopType() & ONSF_NO_STOP_AT_DESTINATION_STATION) == 0) {
-		if (cargo_mask == 0) {
-			can_load_or_unload = true;
-		} else if (next->GetUnloadType() == OUFB_CARGO_TYPE_UNLOAD || next->GetLoadType() == OLFB_CARGO_TYPE_LOAD) {
-			/* This is a cargo-specific load/unload order.
-			 * If the first cargo is both a no-load and no-unload order, skip it.
-			 * Drop cargoes which don't match the first one. */
-			can_load_or_unload = CargoMaskValueFilter<bool>(cargo_mask, [&](CargoID cargo) {
-				return ((next->GetCargoLoadType(cargo) & OLFB_NO_LOAD) == 0 || (next->GetCargoUnloadType(cargo) & OUFB_NO_UNLOAD) == 0);
-			});
-		} else if ((next->GetLoadType() & OLFB_NO_LOAD) == 0 || (next->GetUnloadType() & OUFB_NO_UNLOAD) == 0) {
-			can_load_or_unload = true;
+		bool can_load_or_unload = false;
+		if ((next->IsType(OT_GOTO_STATION) || next->IsType(OT_IMPLICIT)) &&
+				(next->GetNonStopType() & ONSF_NO_STOP_AT_DESTINATION_STATION) == 0) {
+			if (cargo_mask == 0) {
+				can_load_or_unload = true;
+			} else if (next->GetUnloadType() == OUFB_CARGO_TYPE_UNLOAD || next->GetLoadType() == OLFB_CARGO_TYPE_LOAD) {
+				/* This is a cargo-specific load/unload order.
+				 * If the first cargo is both a no-load and no-unload order, skip it.
+				 * Drop cargoes which don't match the first one. */
+				can_load_or_unload = CargoMaskValueFilter<bool>(cargo_mask, [&](CargoID cargo) {
+					return ((next->GetCargoLoadType(cargo) & OLFB_NO_LOAD) == 0 || (next->GetCargoUnloadType(cargo) & OUFB_NO_UNLOAD) == 0);
+				});
+			} else if ((next->GetLoadType() & OLFB_NO_LOAD) == 0 || (next->GetUnloadType() & OUFB_NO_UNLOAD) == 0) {
+				can_load_or_unload = true;
+			}
 		}
-	}
 
-	if (!can_load_or_unload) {
-		return this->GetNextDecisionNode(this->GetNext(next), hops + 1, cargo_mask);
+		if (can_load_or_unload) return next;
+
+		next = this->GetNext(next);
+		hops++;
 	}
 
-	return next;
+	return nullptr;
 }
 
 /**
@@ -834,7 +914,14 @@ void OrderList::DebugCheckSanity() const
 			check_timetable_duration += o->GetTimetabledWait() + o->GetTimetabledTravel();
 			check_total_duration += o->GetWaitTime() + o->GetTravelTime();
 		}
+		auto skip = this->decision_node_skips.find(o);
+		if (skip != this->decision_node_skips.end()) {
+			DecisionNodeSkip check_skip = this->ComputeDecisionNodeSkip(o);
+			assert_msg(skip->second.target == check_skip.target && skip->second.hops == check_skip.hops,
+					"%u: %p, %p, %u, %u", check_num_orders - 1, skip->second.target, check_skip.target, skip->second.hops, check_skip.hops);
+		}
 	}
+	assert_msg(this->decision_node_skips.size() <= check_num_orders, "%u, %u", (uint)this->decision_node_skips.size(), check_num_orders);
 	assert_msg(this->GetNumOrders() == check_num_orders, "%u, %u", (uint) this->GetNumOrders(), check_num_orders);
 	assert_msg(this->num_manual_orders == check_num_manual_orders, "%u, %u", this->num_manual_orders, check_num_manual_orders);
 	assert_msg(this->timetable_duration == check_timetable_duration, "%u, %u", this->timetable_duration, check_timetable_duration);
@@ -1275,6 +1362,7 @@ void InsertOrder(Vehicle *v, Order *new_o, VehicleOrderID sel_ord)
 		}
 		cur_order_id++;
 	}
+	v->orders.list->InvalidateOrderCaches();
 
 	/* Make sure to rebuild the whole list */
 	InvalidateWindowClassesData(GetWindowClassForVehicleType(v->type), 0);
@@ -1432,6 +1520,7 @@ void DeleteOrder(Vehicle *v, VehicleOrderID sel_ord)
 		}
 		cur_order_id++;
 	}
+	if (v->orders.list != nullptr) v->orders.list->InvalidateOrderCaches();
 
 	InvalidateWindowClassesData(GetWindowClassForVehicleType(v->type), 0);
 	InvalidateWindowClassesData(WC_DEPARTURES_BOARD, 0);
@@ -1573,6 +1662,7 @@ CommandCost CmdMoveOrder(TileIndex tile, DoCommandFlag flags, uint32 p1, uint32
 				order->SetConditionSkipToOrder(order_id);
 			}
 		}
+		v->orders.list->InvalidateOrderCaches();
 
 		/* Make sure to rebuild the whole list */
 		InvalidateWindowClassesData(GetWindowClassForVehicleType(v->type), 0);
@@ -1636,6 +1726,7 @@ CommandCost CmdReverseOrderList(TileIndex tile, DoCommandFlag flags, uint32 p1,
 					Order *order = v->orders.list->GetOrderAt(order_count);
 					order->SetRefit(new_order.GetRefitCargo());
 					order->SetMaxSpeed(new_order.GetMaxSpeed());
+					v->orders.list->InvalidateOrderCaches();
 					if (wait_fixed) {
 						extern void SetOrderFixedWaitTime(Vehicle *v, VehicleOrderID order_number, uint32 wait_time, bool wait_timetabled);
 						SetOrderFixedWaitTime(v, order_count, new_order.GetWaitTime(), wait_timetabled);
@@ -2079,6 +2170,7 @@ CommandCost CmdModifyOrder(TileIndex tile, DoCommandFlag flags, uint32 p1, uint3
 
 			default: NOT_REACHED();
 		}
+		v->orders.list->InvalidateOrderCaches();
 
 		/* Update the windows and full load flags, also for vehicles that share the same order list */
 		Vehicle *u = v->FirstShared();
@@ -2469,6 +2561,7 @@ CommandCost CmdOrderRefit(TileIndex tile, DoCommandFlag flags, uint32 p1, uint32
 			order->SetDepotOrderType((OrderDepotTypeFlags)(order->GetDepotOrderType() & ~ODTFB_SERVICE));
 			order->SetDepotActionType((OrderDepotActionFlags)(order->GetDepotActionType() & ~(ODATFB_HALT | ODATFB_SELL)));
 		}
+		v->orders.list->InvalidateOrderCaches();
 
 		for (Vehicle *u = v->FirstShared(); u != nullptr; u = u->NextShared()) {
 			/* Update any possible open window of the vehicle */
@@ -87,6 +87,7 @@ struct TrainReservationLookAhead {
 	int16 tunnel_bridge_reserved_tiles;   ///< How many tiles a reservation into the tunnel/bridge currently extends into the wormhole
 	uint16 flags;                         ///< Flags (TrainReservationLookAheadFlags)
 	uint16 speed_restriction;
+	int16 lowest_item_z = INT16_MAX;      ///< Lower bound of the z coordinate of all items, this is not saved
 	std::deque<TrainReservationLookAheadItem> items;
 	std::deque<TrainReservationLookAheadCurve> curves;
 
@@ -95,41 +96,55 @@ struct TrainReservationLookAhead {
 		return this->reservation_end_position - (this->tunnel_bridge_reserved_tiles * TILE_SIZE);
 	}
 
+	void AddItem(const TrainReservationLookAheadItem &item)
+	{
+		this->items.push_back(item);
+		this->lowest_item_z = std::min(this->lowest_item_z, item.z_pos);
+	}
+
+	void RecalculateLowestItemZ()
+	{
+		this->lowest_item_z = INT16_MAX;
+		for (const TrainReservationLookAheadItem &item : this->items) {
+			this->lowest_item_z = std::min(this->lowest_item_z, item.z_pos);
+		}
+	}
+
 	void AddStation(int tiles, StationID id, int16 z_pos)
 	{
 		int end = this->RealEndPosition();
-		this->items.push_back({ end, end + (((int)TILE_SIZE) * tiles), z_pos, id, TRLIT_STATION });
+		this->AddItem({ end, end + (((int)TILE_SIZE) * tiles), z_pos, id, TRLIT_STATION });
 	}
 
 	void AddReverse(int16 z_pos)
 	{
 		int end = this->RealEndPosition();
-		this->items.push_back({ end, end, z_pos, 0, TRLIT_REVERSE });
+		this->AddItem({ end, end, z_pos, 0, TRLIT_REVERSE });
 	}
 
 	void AddTrackSpeedLimit(uint16 speed, int offset, int duration, int16 z_pos)
 	{
 		int end = this->RealEndPosition();
-		this->items.push_back({ end + offset, end + offset + duration, z_pos, speed, TRLIT_TRACK_SPEED });
+		this->AddItem({ end + offset, end + offset + duration, z_pos, speed, TRLIT_TRACK_SPEED });
 	}
 
 	void AddSpeedRestriction(uint16 speed, int16 z_pos)
 	{
 		int end = this->RealEndPosition();
-		this->items.push_back({ end, end, z_pos, speed, TRLIT_SPEED_RESTRICTION });
+		this->AddItem({ end, end, z_pos, speed, TRLIT_SPEED_RESTRICTION });
 		this->speed_restriction = speed;
 	}
 
 	void AddSignal(uint16 target_speed, int offset, int16 z_pos)
 	{
 		int end = this->RealEndPosition();
-		this->items.push_back({ end + offset, end + offset, z_pos, target_speed, TRLIT_SIGNAL });
+		this->AddItem({ end + offset, end + offset, z_pos, target_speed, TRLIT_SIGNAL });
 	}
 
 	void AddCurveSpeedLimit(uint16 target_speed, int offset, int16 z_pos)
 	{
 		int end = this->RealEndPosition();
-		this->items.push_back({ end + offset, end + offset, z_pos, target_speed, TRLIT_CURVE_SPEED });
+		this->AddItem({ end + offset, end + offset, z_pos, target_speed, TRLIT_CURVE_SPEED });
 	}
 };
 
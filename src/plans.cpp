@@ -20,7 +20,7 @@ Plan *_new_plan = nullptr;
 
 void PlanLine::UpdateVisualExtents()
 {
-	if (_network_dedicated) return;
+	if (IsHeadless()) return;
 
 	if (this->tiles.size() < 2) {
 		this->viewport_extents = { INT_MAX, INT_MAX, INT_MAX, INT_MAX };
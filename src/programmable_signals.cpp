@@ -15,10 +15,17 @@
 #include "window_func.h"
 #include "company_func.h"
 #include "cmd_helper.h"
+#include "string_func.h"
+
+#include <algorithm>
 
 ProgramList _signal_programs;
 bool _cleaning_signal_programs = false;
 
+static std::vector<SignalReference> _pending_dependant_updates; ///< Programmable signals awaiting an update due to a changed slot/counter, while batching
+static uint _dependant_update_batch_level = 0;                   ///< Batching is active when non-zero
+ProgrammableSignalDependantUpdateStats _progsig_dependant_update_stats;
+
 SignalProgram::SignalProgram(TileIndex tile, Track track, bool raw)
 {
 	this->tile  = tile;
@@ -639,6 +646,80 @@ void RemoveProgramCounterDependencies(TraceRestrictCounterID ctr_being_removed,
 	UpdateSignalsInBuffer();
 }
 
+static void UpdateProgrammableSignalDependant(SignalReference sr)
+{
+	Owner owner = GetTileOwner(sr.tile);
+	UpdateSignalsInBufferIfOwnerNotAddable(owner);
+	AddTrackToSignalBuffer(sr.tile, sr.track, owner);
+}
+
+/**
+ * Update the programmable signals which depend on a slot or counter, after the slot occupancy or counter value has changed.
+ * While batching is active (see BeginProgrammableSignalDependantUpdateBatch), the signals are instead
+ * updated once each when the batch ends, regardless of how many times their inputs changed.
+ * @param dependants Signals to update
+ */
+void UpdateProgrammableSignalDependants(const std::vector<SignalReference> &dependants)
+{
+	if (dependants.empty()) return;
+
+	_progsig_dependant_update_stats.requested += (uint64)dependants.size();
+	if (_dependant_update_batch_level > 0) {
+		_pending_dependant_updates.insert(_pending_dependant_updates.end(), dependants.begin(), dependants.end());
+		return;
+	}
+
+	_progsig_dependant_update_stats.performed += (uint64)dependants.size();
+	for (SignalReference sr : dependants) {
+		UpdateProgrammableSignalDependant(sr);
+	}
+	UpdateSignalsInBuffer();
+}
+
+/**
+ * Start batching updates of programmable signals depending on slots and counters.
+ * Batches may be nested, the updates are performed when the outermost batch ends.
+ */
+void BeginProgrammableSignalDependantUpdateBatch()
+{
+	_dependant_update_batch_level++;
+}
+
+/**
+ * End a batch of updates of programmable signals depending on slots and counters.
+ * At the end of the outermost batch, each signal pending update is updated once, in a deterministic order.
+ */
+void EndProgrammableSignalDependantUpdateBatch()
+{
+	assert(_dependant_update_batch_level > 0);
+	_dependant_update_batch_level--;
+	if (_dependant_update_batch_level > 0 || _pending_dependant_updates.empty()) return;
+
+	_progsig_dependant_update_stats.batches++;
+
+	/* Updating signals may change further slots or counters, so take a copy of the pending list */
+	std::vector<SignalReference> pending = std::move(_pending_dependant_updates);
+	_pending_dependant_updates.clear();
+	std::sort(pending.begin(), pending.end());
+	pending.erase(std::unique(pending.begin(), pending.end()), pending.end());
+
+	_progsig_dependant_update_stats.performed += (uint64)pending.size();
+	for (SignalReference sr : pending) {
+		UpdateProgrammableSignalDependant(sr);
+	}
+	UpdateSignalsInBuffer();
+}
+
+void DumpProgrammableSignalDependantUpdateStats(char *b, const char *last)
+{
+	const ProgrammableSignalDependantUpdateStats &stats = _progsig_dependant_update_stats;
+	b += seprintf(b, last, "Programmable signal slot/counter dependant updates:\n");
+	b += seprintf(b, last, "  Requested: " OTTD_PRINTF64U "\n", stats.requested);
+	b += seprintf(b, last, "  Performed: " OTTD_PRINTF64U "\n", stats.performed);
+	b += seprintf(b, last, "  Avoided:   " OTTD_PRINTF64U "\n", stats.requested - stats.performed);
+	b += seprintf(b, last, "  Batches:   " OTTD_PRINTF64U "\n", stats.batches);
+}
+
 void SignalProgram::DebugPrintProgram()
 {
 	DEBUG(misc, 5, "Program %p listing", this);
@@ -439,6 +439,26 @@ SignalState RunSignalProgram(SignalReference ref, uint num_exits, uint num_green
 
 /// Remove dependencies on signal @p on from @p by
 void RemoveProgramDependencies(SignalReference dependency_target, SignalReference signal_to_update);
+
+/// Statistics of updates of programmable signals depending on slots and counters
+struct ProgrammableSignalDependantUpdateStats {
+	uint64 requested = 0;  ///< Number of signal updates requested due to slot/counter changes
+	uint64 performed = 0;  ///< Number of signal updates actually performed
+	uint64 batches = 0;    ///< Number of non-empty batches flushed
+};
+
+/// Update the programmable signals which depend on a changed slot or counter
+void UpdateProgrammableSignalDependants(const std::vector<SignalReference> &dependants);
+
+/// Start/end batching updates of programmable signals depending on slots and counters
+void BeginProgrammableSignalDependantUpdateBatch();
+void EndProgrammableSignalDependantUpdateBatch();
+
+/// Batch updates of programmable signals depending on slots and counters, for the lifetime of this object
+struct ProgrammableSignalDependantUpdateBatch {
+	ProgrammableSignalDependantUpdateBatch() { BeginProgrammableSignalDependantUpdateBatch(); }
+	~ProgrammableSignalDependantUpdateBatch() { EndProgrammableSignalDependantUpdateBatch(); }
+};
 ///@}
 
 #endif
@@ -792,6 +792,7 @@ static CommandCost RemoveRoad(TileIndex tile, DoCommandFlag flags, RoadBits piec
 				}
 				if (rtt == RTT_ROAD) {
 					UpdateRoadCachedOneWayStatesAroundTile(tile);
+					UpdateTownGrowthFrontierAroundTile(tile);
 				}
 			}
 
@@ -1434,6 +1435,7 @@ do_clear:;
 		}
 		if (rtt == RTT_ROAD) {
 			UpdateRoadCachedOneWayStatesAroundTile(tile);
+			UpdateTownGrowthFrontierAroundTile(tile);
 		}
 
 		MarkTileDirtyByTile(tile);
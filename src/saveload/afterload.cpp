@@ -27,6 +27,7 @@
 #include "../roadveh.h"
 #include "../train.h"
 #include "../station_base.h"
+#include "../station_func.h"
 #include "../waypoint_base.h"
 #include "../roadstop_base.h"
 #include "../tunnelbridge_map.h"
@@ -3893,6 +3894,8 @@ bool AfterLoadGame()
 
 	if (SlXvIsFeatureMissing(XSLFI_ANIMATED_TILE_EXTRA)) {
 		UpdateAllAnimatedTileSpeeds();
+	} else {
+		RebuildAnimatedTileSpeedBuckets();
 	}
 
 	if (!SlXvIsFeaturePresent(XSLFI_REALISTIC_TRAIN_BRAKING, 2)) {
@@ -3944,6 +3947,7 @@ bool AfterLoadGame()
 	AfterLoadLabelMaps();
 	AfterLoadCompanyStats();
 	AfterLoadStoryBook();
+	RebuildTownGrowthSchedule();
 
 	GamelogPrintDebug(1);
 
@@ -4045,6 +4049,8 @@ void ReloadNewGRFData()
 	AfterLoadCompanyStats();
 	/* Check and update house and town values */
 	UpdateHousesAndTowns(true, false);
+	/* House callbacks may have changed, so re-classify station acceptance tiles */
+	InvalidateAllStationAcceptanceCaches();
 	/* Delete news referring to no longer existing entities */
 	DeleteInvalidEngineNews();
 	/* Update livery selection windows */
@@ -91,66 +91,67 @@ CompanyManagerFace ConvertFromOldCompanyManagerFace(uint32 face)
 	return cmf;
 }
 
-/** Rebuilding of company statistics after loading a savegame. */
-void AfterLoadCompanyStats()
+/**
+ * Count company infrastructure from the map and the stations.
+ * @param get_infra Function returning the counts to add the infrastructure of an owner to, or nullptr to skip the owner.
+ */
+static void CountCompanyInfrastructure(const std::function<CompanyInfrastructure *(Owner)> &get_infra)
 {
-	/* Reset infrastructure statistics to zero. */
-	for (Company *c : Company::Iterate()) MemSetT(&c->infrastructure, 0);
-
 	/* Collect airport count. */
 	for (const Station *st : Station::Iterate()) {
-		if ((st->facilities & FACIL_AIRPORT) && Company::IsValidID(st->owner)) {
-			Company::Get(st->owner)->infrastructure.airport++;
+		if (st->facilities & FACIL_AIRPORT) {
+			CompanyInfrastructure *infra = get_infra(st->owner);
+			if (infra != nullptr) infra->airport++;
 		}
 	}
 
-	Company *c;
+	CompanyInfrastructure *c;
 	for (TileIndex tile = 0; tile < MapSize(); tile++) {
 		switch (GetTileType(tile)) {
 			case MP_RAILWAY:
-				c = Company::GetIfValid(GetTileOwner(tile));
+				c = get_infra(GetTileOwner(tile));
 				if (c != nullptr) {
 					uint pieces = 1;
 					if (IsPlainRail(tile)) {
 						TrackBits bits = GetTrackBits(tile);
 						if (bits == TRACK_BIT_HORZ || bits == TRACK_BIT_VERT) {
-							c->infrastructure.rail[GetSecondaryRailType(tile)]++;
+							c->rail[GetSecondaryRailType(tile)]++;
 						} else {
 							pieces = CountBits(bits);
 							if (TracksOverlap(bits)) pieces *= pieces;
 						}
 					}
-					c->infrastructure.rail[GetRailType(tile)] += pieces;
+					c->rail[GetRailType(tile)] += pieces;
 
-					if (HasSignals(tile)) c->infrastructure.signal += CountBits(GetPresentSignals(tile));
+					if (HasSignals(tile)) c->signal += CountBits(GetPresentSignals(tile));
 				}
 				break;
 
 			case MP_ROAD: {
 				if (IsLevelCrossing(tile)) {
-					c = Company::GetIfValid(GetTileOwner(tile));
-					if (c != nullptr) c->infrastructure.rail[GetRailType(tile)] += LEVELCROSSING_TRACKBIT_FACTOR;
+					c = get_infra(GetTileOwner(tile));
+					if (c != nullptr) c->rail[GetRailType(tile)] += LEVELCROSSING_TRACKBIT_FACTOR;
 				}
 
 				/* Iterate all present road types as each can have a different owner. */
 				for (RoadTramType rtt : _roadtramtypes) {
 					RoadType rt = GetRoadType(tile, rtt);
 					if (rt == INVALID_ROADTYPE) continue;
-					c = Company::GetIfValid(IsRoadDepot(tile) ? GetTileOwner(tile) : GetRoadOwner(tile, rtt));
+					c = get_infra(IsRoadDepot(tile) ? GetTileOwner(tile) : GetRoadOwner(tile, rtt));
 					/* A level crossings and depots have two road bits. */
-					if (c != nullptr) c->infrastructure.road[rt] += IsNormalRoad(tile) ? CountBits(GetRoadBits(tile, rtt)) : 2;
+					if (c != nullptr) c->road[rt] += IsNormalRoad(tile) ? CountBits(GetRoadBits(tile, rtt)) : 2;
 				}
 				break;
 			}
 
 			case MP_STATION:
-				c = Company::GetIfValid(GetTileOwner(tile));
-				if (c != nullptr && GetStationType(tile) != STATION_AIRPORT && !IsBuoy(tile)) c->infrastructure.station++;
+				c = get_infra(GetTileOwner(tile));
+				if (c != nullptr && GetStationType(tile) != STATION_AIRPORT && !IsBuoy(tile)) c->station++;
 
 				switch (GetStationType(tile)) {
 					case STATION_RAIL:
 					case STATION_WAYPOINT:
-						if (c != nullptr && !IsStationTileBlocked(tile)) c->infrastructure.rail[GetRailType(tile)]++;
+						if (c != nullptr && !IsStationTileBlocked(tile)) c->rail[GetRailType(tile)]++;
 						break;
 
 					case STATION_BUS:
@@ -159,8 +160,8 @@ void AfterLoadCompanyStats()
 						for (RoadTramType rtt : _roadtramtypes) {
 							RoadType rt = GetRoadType(tile, rtt);
 							if (rt == INVALID_ROADTYPE) continue;
-							c = Company::GetIfValid(GetRoadOwner(tile, rtt));
-							if (c != nullptr) c->infrastructure.road[rt] += 2; // A road stop has two road bits.
+							c = get_infra(GetRoadOwner(tile, rtt));
+							if (c != nullptr) c->road[rt] += 2; // A road stop has two road bits.
 						}
 						break;
 					}
@@ -168,7 +169,7 @@ void AfterLoadCompanyStats()
 					case STATION_DOCK:
 					case STATION_BUOY:
 						if (GetWaterClass(tile) == WATER_CLASS_CANAL) {
-							if (c != nullptr) c->infrastructure.water++;
+							if (c != nullptr) c->water++;
 						}
 						break;
 
@@ -179,12 +180,12 @@ void AfterLoadCompanyStats()
 
 			case MP_WATER:
 				if (IsShipDepot(tile) || IsLock(tile)) {
-					c = Company::GetIfValid(GetTileOwner(tile));
+					c = get_infra(GetTileOwner(tile));
 					if (c != nullptr) {
-						if (IsShipDepot(tile)) c->infrastructure.water += LOCK_DEPOT_TILE_FACTOR;
+						if (IsShipDepot(tile)) c->water += LOCK_DEPOT_TILE_FACTOR;
 						if (IsLock(tile) && GetLockPart(tile) == LOCK_PART_MIDDLE) {
 							/* The middle tile specifies the owner of the lock. */
-							c->infrastructure.water += 3 * LOCK_DEPOT_TILE_FACTOR; // the middle tile specifies the owner of the
+							c->water += 3 * LOCK_DEPOT_TILE_FACTOR; // the middle tile specifies the owner of the
 							break; // do not count the middle tile as canal
 						}
 					}
@@ -193,8 +194,8 @@ void AfterLoadCompanyStats()
 
 			case MP_OBJECT:
 				if (GetWaterClass(tile) == WATER_CLASS_CANAL) {
-					c = Company::GetIfValid(GetTileOwner(tile));
-					if (c != nullptr) c->infrastructure.water++;
+					c = get_infra(GetTileOwner(tile));
+					if (c != nullptr) c->water++;
 				}
 				break;
 
@@ -208,17 +209,18 @@ void AfterLoadCompanyStats()
 
 					switch (GetTunnelBridgeTransportType(tile)) {
 						case TRANSPORT_RAIL:
-							AddRailTunnelBridgeInfrastructure(tile, other_end);
+							c = get_infra(GetTileOwner(tile));
+							if (c != nullptr) AddRailTunnelBridgeInfrastructure(*c, tile, other_end);
 							break;
 
 						case TRANSPORT_ROAD: {
-							AddRoadTunnelBridgeInfrastructure(tile, other_end);
+							AddRoadTunnelBridgeInfrastructure(tile, other_end, get_infra);
 							break;
 						}
 
 						case TRANSPORT_WATER:
-							c = Company::GetIfValid(GetTileOwner(tile));
-							if (c != nullptr) c->infrastructure.water += middle_len + (2 * TUNNELBRIDGE_TRACKBIT_FACTOR);
+							c = get_infra(GetTileOwner(tile));
+							if (c != nullptr) c->water += middle_len + (2 * TUNNELBRIDGE_TRACKBIT_FACTOR);
 							break;
 
 						default:
@@ -234,6 +236,31 @@ void AfterLoadCompanyStats()
 	}
 }
 
+/** Rebuilding of company statistics after loading a savegame. */
+void AfterLoadCompanyStats()
+{
+	/* Reset infrastructure statistics to zero. */
+	for (Company *c : Company::Iterate()) MemSetT(&c->infrastructure, 0);
+
+	CountCompanyInfrastructure([](Owner owner) -> CompanyInfrastructure * {
+		Company *c = Company::GetIfValid(owner);
+		return c != nullptr ? &c->infrastructure : nullptr;
+	});
+}
+
+/**
+ * Recount the infrastructure of some companies without changing their cached counts.
+ * @param companies Companies to count the infrastructure of.
+ * @param[out] infra Recounted infrastructure, indexed by company.
+ */
+void RecountCompanyInfrastructure(CompanyMask companies, CompanyInfrastructure (&infra)[MAX_COMPANIES])
+{
+	MemSetT(infra, 0, MAX_COMPANIES);
+	CountCompanyInfrastructure([&](Owner owner) -> CompanyInfrastructure * {
+		return (owner < MAX_COMPANIES && HasBit(companies, owner)) ? &infra[owner] : nullptr;
+	});
+}
+
 
 
 /* Save/load of companies */
@@ -239,6 +239,9 @@ static const SaveLoad _town_desc[] = {
 	SLE_CONDVAR(Town, layout,                SLE_UINT8,                SLV_113, SL_MAX_VERSION),
 
 	SLE_CONDLST(Town, psa_list,            REF_STORAGE,                SLV_161, SL_MAX_VERSION),
+	SLE_CONDVARVEC_X(Town, growth_frontier, SLE_UINT32,                SL_MIN_VERSION, SL_MAX_VERSION, SlXvFeatureTest(XSLFTO_AND, XSLFI_TOWN_GROWTH_FRONTIER)),
+	SLE_CONDVARVEC_X(Town, growth_frontier_failures, SLE_UINT8,        SL_MIN_VERSION, SL_MAX_VERSION, SlXvFeatureTest(XSLFTO_AND, XSLFI_TOWN_GROWTH_FRONTIER, 2)),
+	SLE_CONDVAR_X(Town, growth_frontier_built, SLE_BOOL,               SL_MIN_VERSION, SL_MAX_VERSION, SlXvFeatureTest(XSLFTO_AND, XSLFI_TOWN_GROWTH_FRONTIER, 2)),
 
 	SLE_CONDNULL(4, SLV_166, SLV_EXTEND_CARGOTYPES),  ///< cargo_produced, no longer in use
 	SLE_CONDNULL(8, SLV_EXTEND_CARGOTYPES, SLV_REMOVE_TOWN_CARGO_CACHE),  ///< cargo_produced, no longer in use
@@ -311,6 +314,7 @@ static void Save_TOWN()
 {
 	SetupDescs_TOWN();
 	for (Town *t : Town::Iterate()) {
+		t->grow_counter = t->GetGrowCounter();
 		SlSetArrayIndex(t->index);
 		SlAutolength((AutolengthProc*)RealSave_Town, t);
 	}
@@ -343,6 +347,13 @@ static void Load_TOWN()
 			SlErrorCorrupt("Invalid town name generator");
 		}
 
+		if (SlXvIsFeatureMissing(XSLFI_TOWN_GROWTH_FRONTIER, 2)) {
+			t->growth_frontier_failures.assign(t->growth_frontier.size(), 0);
+			t->growth_frontier_built = !t->growth_frontier.empty();
+		} else if (t->growth_frontier_failures.size() != t->growth_frontier.size()) {
+			SlErrorCorrupt("Invalid town growth frontier");
+		}
+
 		if ((!IsSavegameVersionBefore(SLV_166) && IsSavegameVersionBefore(SLV_REMOVE_TOWN_CARGO_CACHE)) || SlXvIsFeaturePresent(XSLFI_TOWN_CARGO_MATRIX)) {
 			SlSkipBytes(4); // tile
 			uint16 w = SlReadUint16();
@@ -1467,6 +1467,7 @@ void Load_VLKA()
 		for (uint i = 0; i < items; i++) {
 			SlObject(&t->lookahead->items[i], GetVehicleLookAheadItemDescription());
 		}
+		t->lookahead->RecalculateLowestItemZ();
 		uint32 curves = SlReadUint32();
 		t->lookahead->curves.resize(curves);
 		for (uint i = 0; i < curves; i++) {
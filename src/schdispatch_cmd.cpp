@@ -347,6 +347,40 @@ void OrderList::UpdateScheduledDispatch()
 	if (update_windows) InvalidateWindowClassesData(WC_SCHDISPATCH_SLOTS, VIWD_MODIFY_ORDERS);
 }
 
+/**
+ * Get the departure time of the next scheduled dispatch slot available to a vehicle.
+ * This is the earliest slot after both the last dispatched slot and @p earliest_exclusive.
+ * @param earliest_exclusive The slot must be strictly after this time, in absolute scaled ticks.
+ * @param used_slots If not nullptr, slots with a departure time in this set are skipped, as they are already allocated to another prediction.
+ * @return The departure time of the slot, in absolute scaled ticks, or -1 if there are no slots.
+ */
+DateTicksScaled OrderList::GetScheduledDispatchNextSlot(DateTicksScaled earliest_exclusive, const std::set<DateTicksScaled> *used_slots) const
+{
+	const DateTicksScaled begin_time = this->GetScheduledDispatchStartTick();
+	const uint32 dispatch_duration = this->GetScheduledDispatchDuration();
+	earliest_exclusive = std::max<DateTicksScaled>(earliest_exclusive, begin_time + this->GetScheduledDispatchLastDispatch());
+
+	DateTicksScaled first_slot = -1;
+	for (uint32 current_offset : this->GetScheduledDispatch()) {
+		if (current_offset >= dispatch_duration) continue;
+
+		DateTicksScaled current_departure = begin_time + current_offset;
+		if (current_departure <= earliest_exclusive) {
+			current_departure += dispatch_duration * (((earliest_exclusive - current_departure) / dispatch_duration) + 1);
+		}
+		if (used_slots != nullptr) {
+			while (used_slots->count(current_departure) > 0) {
+				current_departure += dispatch_duration;
+			}
+		}
+
+		if (first_slot == -1 || first_slot > current_departure) {
+			first_slot = current_departure;
+		}
+	}
+	return first_slot;
+}
+
 /**
  * Reset the scheduled dispatch schedule.
  *
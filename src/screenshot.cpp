@@ -29,6 +29,12 @@
 #include "smallmap_colours.h"
 #include "smallmap_gui.h"
 #include "screenshot_gui.h"
+#include "thread.h"
+#include "core/backup_type.hpp"
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
 
 #include "table/strings.h"
 
@@ -43,6 +49,7 @@ uint _cur_screenshot_format;          ///< Index of the currently selected scree
 static char _screenshot_name[128];    ///< Filename of the screenshot file.
 char _full_screenshot_name[MAX_PATH]; ///< Pathname of the screenshot file.
 uint _heightmap_highest_peak;         ///< When saving a heightmap, this contains the highest peak on the map.
+static bool _screenshot_pipelined = false; ///< Whether the image writers may write a band of lines on a separate thread while the next band is generated.
 
 static const char *_screenshot_aux_text_key = nullptr;
 static const char *_screenshot_aux_text_value = nullptr;
@@ -76,6 +83,99 @@ typedef void ScreenshotCallback(void *userdata, void *buf, uint y, uint pitch, u
  */
 typedef bool ScreenshotHandlerProc(const char *name, ScreenshotCallback *callb, void *userdata, uint w, uint h, int pixelformat, const Colour *palette);
 
+/**
+ * Generate the lines of an image band by band and pass them on to a writer.
+ * If #_screenshot_pipelined is set, the bands are written on a separate thread,
+ * such that the next band is generated by \a callb while the previous one is written out.
+ * The bands are always generated, and written, in order.
+ * @param callb    Callback function for generating lines of pixels.
+ * @param userdata User data, passed on to \a callb.
+ * @param w        Width of the image in pixels.
+ * @param h        Height of the image in pixels.
+ * @param bpp      Bytes per pixel.
+ * @param maxlines Maximum number of lines in a band.
+ * @param write    Function writing \a n lines from a buffer, returning false on failure.
+ * @return True if all lines were written successfully.
+ */
+template <typename F>
+static bool GenerateScreenshotBands(ScreenshotCallback *callb, void *userdata, uint w, uint h, uint bpp, uint maxlines, F write)
+{
+	std::unique_ptr<uint8[]> buffers[2];
+	const size_t band_size = (size_t)w * maxlines * bpp;
+	buffers[0].reset(new uint8[band_size]());
+	if (_screenshot_pipelined && h > maxlines) buffers[1].reset(new uint8[band_size]());
+
+	std::mutex lock;
+	std::condition_variable cv;
+	uint pending[2] = { 0, 0 }; ///< Number of lines of each buffer which are waiting to be written.
+	bool done = false;          ///< Whether all bands have been generated.
+	bool failed = false;        ///< Whether writing has failed.
+
+	auto writer = [&]() {
+		for (uint band = 0;; band ^= 1) {
+			uint n;
+			{
+				std::unique_lock<std::mutex> guard(lock);
+				cv.wait(guard, [&]() { return pending[band] != 0 || done; });
+				n = pending[band];
+			}
+			if (n == 0) return;
+
+			bool ok = write(buffers[band].get(), n);
+			{
+				std::lock_guard<std::mutex> guard(lock);
+				pending[band] = 0;
+				if (!ok) failed = true;
+			}
+			cv.notify_all();
+			if (!ok) return;
+		}
+	};
+
+	std::thread thread;
+	const bool threaded = buffers[1] != nullptr && StartNewThread(&thread, "ottd:screenshot", [&writer]() { writer(); });
+
+	uint band = 0;
+	uint y = 0;
+	do {
+		/* determine # lines to write */
+		uint n = std::min(h - y, maxlines);
+
+		if (threaded) {
+			std::unique_lock<std::mutex> guard(lock);
+			cv.wait(guard, [&]() { return pending[band] == 0 || failed; });
+			if (failed) break;
+		}
+
+		/* render the pixels into the buffer */
+		callb(userdata, buffers[band].get(), y, w, n);
+		y += n;
+
+		if (threaded) {
+			{
+				std::lock_guard<std::mutex> guard(lock);
+				pending[band] = n;
+			}
+			cv.notify_all();
+			band ^= 1;
+		} else if (!write(buffers[band].get(), n)) {
+			failed = true;
+			break;
+		}
+	} while (y != h);
+
+	if (threaded) {
+		{
+			std::lock_guard<std::mutex> guard(lock);
+			done = true;
+		}
+		cv.notify_all();
+		thread.join();
+	}
+
+	return !failed;
+}
+
 /** Screenshot format information. */
 struct ScreenshotFormat {
 	const char *extension;       ///< File extension.
@@ -274,7 +374,7 @@ static bool MakePNGImage(const char *name, ScreenshotCallback *callb, void *user
 {
 	png_color rq[256];
 	FILE *f;
-	uint i, y, n;
+	uint i;
 	uint maxlines;
 	uint bpp = pixelformat / 8;
 	png_structp png_ptr;
@@ -386,31 +486,37 @@ static bool MakePNGImage(const char *name, ScreenshotCallback *callb, void *user
 #endif /* TTD_ENDIAN == TTD_LITTLE_ENDIAN */
 	}
 
-	/* use by default 64k temp memory */
-	maxlines = Clamp(65536 / w, 16, 128);
-
-	/* now generate the bitmap bits */
-	void *buff = CallocT<uint8>(w * maxlines * bpp); // by default generate 128 lines at a time.
-
-	y = 0;
-	do {
-		/* determine # lines to write */
-		n = std::min(h - y, maxlines);
+	/* Use bands of about 4 MiB, fewer bands mean less overhead of drawing overlapping sprites of neighbouring bands */
+	maxlines = Clamp((4u << 20) / (w * bpp), 16, 512);
 
-		/* render the pixels into the buffer */
-		callb(userdata, buff, y, w, n);
-		y += n;
+	/* now generate the bitmap bits; the rows may be compressed on a different thread,
+	 * which then needs to handle the errors of libpng itself */
+	bool ok = GenerateScreenshotBands(callb, userdata, w, h, bpp, maxlines, [&](uint8 *buff, uint n) -> bool {
+		if (setjmp(png_jmpbuf(png_ptr))) return false;
 
 		/* write them to png */
-		for (i = 0; i != n; i++) {
+		for (uint i = 0; i != n; i++) {
 			png_write_row(png_ptr, (png_bytep)buff + i * w * bpp);
 		}
-	} while (y != h);
+		return true;
+	});
+
+	if (!ok) {
+		png_destroy_write_struct(&png_ptr, &info_ptr);
+		fclose(f);
+		return false;
+	}
+
+	/* Errors need to return here again, the writer may have replaced the jump target. */
+	if (setjmp(png_jmpbuf(png_ptr))) {
+		png_destroy_write_struct(&png_ptr, &info_ptr);
+		fclose(f);
+		return false;
+	}
 
 	png_write_end(png_ptr, info_ptr);
 	png_destroy_write_struct(&png_ptr, &info_ptr);
 
-	free(buff);
 	fclose(f);
 	return true;
 }
@@ -623,18 +729,19 @@ static void CurrentScreenCallback(void *userdata, void *buf, uint y, uint pitch,
 }
 
 /**
- * generate a large piece of the world
- * @param userdata Viewport area to draw
+ * Draw a rectangle of a screenshot viewport into a buffer.
+ * @param vp Viewport area to draw
  * @param buf Videobuffer with same bitdepth as current blitter
- * @param y First line to render
+ * @param left First column to render
+ * @param top First line to render
+ * @param width Number of columns to render
+ * @param height Number of lines to render
  * @param pitch Pitch of the videobuffer
- * @param n Number of lines to render
  */
-static void LargeWorldCallback(void *userdata, void *buf, uint y, uint pitch, uint n)
+static void DrawLargeWorldArea(Viewport *vp, void *buf, int left, int top, int width, int height, uint pitch)
 {
-	Viewport *vp = (Viewport *)userdata;
 	DrawPixelInfo dpi, *old_dpi;
-	int wx, left;
+	int wx, right;
 
 	/* We are no longer rendering to the screen */
 	DrawPixelInfo old_screen = _screen;
@@ -642,7 +749,7 @@ static void LargeWorldCallback(void *userdata, void *buf, uint y, uint pitch, ui
 
 	_screen.dst_ptr = buf;
 	_screen.width = pitch;
-	_screen.height = n;
+	_screen.height = height;
 	_screen.pitch = pitch;
 	_screen_disable_anim = true;
 
@@ -650,24 +757,24 @@ static void LargeWorldCallback(void *userdata, void *buf, uint y, uint pitch, ui
 	_cur_dpi = &dpi;
 
 	dpi.dst_ptr = buf;
-	dpi.height = n;
-	dpi.width = vp->width;
+	dpi.height = height;
+	dpi.width = width;
 	dpi.pitch = pitch;
 	dpi.zoom = ZOOM_LVL_WORLD_SCREENSHOT;
-	dpi.left = 0;
-	dpi.top = y;
+	dpi.left = left;
+	dpi.top = top;
 
 	/* Render viewport in blocks of 1600 pixels width */
-	left = 0;
-	while (vp->width - left != 0) {
-		wx = std::min(vp->width - left, 1600);
-		left += wx;
+	right = left;
+	while (left + width - right != 0) {
+		wx = std::min(left + width - right, 1600);
+		right += wx;
 
 		ViewportDoDraw(vp,
-			ScaleByZoom(left - wx - vp->left, vp->zoom) + vp->virtual_left,
-			ScaleByZoom(y - vp->top, vp->zoom) + vp->virtual_top,
-			ScaleByZoom(left - vp->left, vp->zoom) + vp->virtual_left,
-			ScaleByZoom((y + n) - vp->top, vp->zoom) + vp->virtual_top
+			ScaleByZoom(right - wx - vp->left, vp->zoom) + vp->virtual_left,
+			ScaleByZoom(top - vp->top, vp->zoom) + vp->virtual_top,
+			ScaleByZoom(right - vp->left, vp->zoom) + vp->virtual_left,
+			ScaleByZoom((top + height) - vp->top, vp->zoom) + vp->virtual_top
 		);
 	}
 
@@ -680,6 +787,41 @@ static void LargeWorldCallback(void *userdata, void *buf, uint y, uint pitch, ui
 	ClearViewportCache(vp);
 }
 
+/**
+ * generate a large piece of the world
+ * @param userdata Viewport area to draw
+ * @param buf Videobuffer with same bitdepth as current blitter
+ * @param y First line to render
+ * @param pitch Pitch of the videobuffer
+ * @param n Number of lines to render
+ */
+static void LargeWorldCallback(void *userdata, void *buf, uint y, uint pitch, uint n)
+{
+	Viewport *vp = (Viewport *)userdata;
+	DrawLargeWorldArea(vp, buf, 0, y, vp->width, n, pitch);
+}
+
+/** Part of a screenshot viewport to draw as a tile of a tiled screenshot. */
+struct LargeWorldTile {
+	Viewport *vp; ///< Viewport area to draw.
+	int left;     ///< Left column of the tile in the viewport.
+	int top;      ///< Top line of the tile in the viewport.
+};
+
+/**
+ * generate a tile of a tiled screenshot of the world
+ * @param userdata #LargeWorldTile to draw
+ * @param buf Videobuffer with same bitdepth as current blitter
+ * @param y First line of the tile to render
+ * @param pitch Pitch of the videobuffer, the width of the tile
+ * @param n Number of lines to render
+ */
+static void LargeWorldTileCallback(void *userdata, void *buf, uint y, uint pitch, uint n)
+{
+	LargeWorldTile *tile = (LargeWorldTile *)userdata;
+	DrawLargeWorldArea(tile->vp, buf, tile->left, tile->top + y, pitch, n, pitch);
+}
+
 /**
  * Construct a pathname for a screenshot file.
  * @param default_fn Default filename.
@@ -829,9 +971,66 @@ static bool MakeLargeWorldScreenshot(ScreenshotType t, uint32 width = 0, uint32
 	Viewport vp;
 	SetupScreenshotViewport(t, &vp, width, height);
 
+	/* Drawing the world is slow; let the image writers work on the previous band meanwhile. */
+	Backup<bool> pipelined(_screenshot_pipelined, true, FILE_LINE);
+
 	const ScreenshotFormat *sf = _screenshot_formats + _cur_screenshot_format;
-	return sf->proc(MakeScreenshotName(SCREENSHOT_NAME, sf->extension), LargeWorldCallback, &vp, vp.width, vp.height,
+	bool ret = sf->proc(MakeScreenshotName(SCREENSHOT_NAME, sf->extension), LargeWorldCallback, &vp, vp.width, vp.height,
 			BlitterFactory::GetCurrentBlitter()->GetScreenDepth(), _cur_palette.palette);
+
+	pipelined.Restore();
+	return ret;
+}
+
+/** Width and height in pixels of the images of a tiled world screenshot. */
+static const int SCREENSHOT_TILE_SIZE = 256;
+
+/**
+ * Make a screenshot of the whole map as a pyramid of image tiles, as used by web map viewers.
+ * Level 0 is zoomed out until the world fits on a single tile, or as far as possible,
+ * and every next level is zoomed in twice as far, up to the zoom level of the world screenshot.
+ * The tiles are written to \c \<level\>/\<column\>/\<row\>.\<extension\> in a directory named like a regular screenshot.
+ * @return true on success
+ */
+static bool MakeTiledWorldScreenshot()
+{
+	Viewport vp;
+	SetupScreenshotViewport(SC_WORLD, &vp);
+	const Window *w = FindWindowById(WC_MAIN_WINDOW, 0);
+	vp.map_type = (w != nullptr && w->viewport != nullptr) ? w->viewport->map_type : VPMT_VEGETATION;
+
+	ZoomLevel top_zoom = ZOOM_LVL_WORLD_SCREENSHOT;
+	while (top_zoom < ZOOM_LVL_MAX && (UnScaleByZoom(vp.virtual_width, top_zoom) > SCREENSHOT_TILE_SIZE || UnScaleByZoom(vp.virtual_height, top_zoom) > SCREENSHOT_TILE_SIZE)) {
+		top_zoom++;
+	}
+
+	const ScreenshotFormat *sf = _screenshot_formats + _cur_screenshot_format;
+	const std::string directory = MakeScreenshotName(SCREENSHOT_NAME, "tiles");
+	if (directory.empty()) return false;
+
+	for (int zoom = top_zoom; zoom >= ZOOM_LVL_WORLD_SCREENSHOT; zoom--) {
+		vp.zoom = (ZoomLevel)zoom;
+		vp.width  = UnScaleByZoom(vp.virtual_width,  vp.zoom);
+		vp.height = UnScaleByZoom(vp.virtual_height, vp.zoom);
+		UpdateViewportSizeZoom(&vp);
+
+		const int level = top_zoom - zoom;
+		for (int column = 0; column * SCREENSHOT_TILE_SIZE < vp.width; column++) {
+			const std::string column_directory = directory + PATHSEP + std::to_string(level) + PATHSEP + std::to_string(column);
+			FioCreateDirectory(column_directory);
+
+			for (int row = 0; row * SCREENSHOT_TILE_SIZE < vp.height; row++) {
+				LargeWorldTile tile = { &vp, column * SCREENSHOT_TILE_SIZE, row * SCREENSHOT_TILE_SIZE };
+				const std::string name = column_directory + PATHSEP + std::to_string(row) + "." + sf->extension;
+				if (!sf->proc(name.c_str(), LargeWorldTileCallback, &tile, SCREENSHOT_TILE_SIZE, SCREENSHOT_TILE_SIZE,
+						BlitterFactory::GetCurrentBlitter()->GetScreenDepth(), _cur_palette.palette)) {
+					return false;
+				}
+			}
+		}
+	}
+
+	return true;
 }
 
 /**
@@ -986,6 +1185,10 @@ static bool RealMakeScreenshot(ScreenshotType t, std::string name, uint32 width,
 			ret = MakeLargeWorldScreenshot(t);
 			break;
 
+		case SC_WORLD_TILES:
+			ret = MakeTiledWorldScreenshot();
+			break;
+
 		case SC_HEIGHTMAP: {
 			const ScreenshotFormat *sf = _screenshot_formats + _cur_screenshot_format;
 			ret = MakeHeightmapScreenshot(MakeScreenshotName(HEIGHTMAP_NAME, sf->extension));
@@ -22,6 +22,7 @@ enum ScreenshotType {
 	SC_DEFAULTZOOM, ///< Zoomed to default zoom level screenshot of the visible area.
 	SC_WORLD,       ///< World screenshot.
 	SC_WORLD_ZOOM,  ///< World screenshot using current zoom level.
+	SC_WORLD_TILES, ///< World screenshot as a pyramid of image tiles of all zoom levels from the world screenshot zoom level outwards.
 	SC_HEIGHTMAP,   ///< Heightmap of the world.
 	SC_MINIMAP,     ///< Minimap screenshot.
 	SC_SMALLMAP,    ///< Smallmap window screenshot.
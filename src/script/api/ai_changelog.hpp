@@ -17,6 +17,27 @@
  *
  * This version is not yet released. The following changes are not set in stone yet.
  *
+ * API additions:
+ * \li AIStationList::ValuateCargoRating
+ * \li AIStationList::ValuateCargoWaiting
+ * \li AIStationList::ValuateDistanceManhattanToTile
+ * \li AITileList::ValuateBuildable
+ * \li AITileList::ValuateCargoAcceptance
+ * \li AITileList::ValuateDistanceManhattanToTile
+ * \li AITileList::ValuateMaxHeight
+ * \li AITileList::ValuateOwner
+ * \li AITileList::ValuateSlope
+ * \li AIVehicleList::ValuateAge
+ * \li AIVehicleList::ValuateProfitLastYear
+ * \li AIVehicleList::ValuateProfitThisYear
+ * \li AIVehicleList::ValuateReliability
+ * \li AIVehicleList::ValuateState
+ * \li AIVehicleList::ValuateVehicleType
+ *
+ * Other changes:
+ * \li AIVehicleList_* are now subclasses of AIVehicleList
+ * \li AIStationList_Vehicle is now a subclass of AIStationList
+ *
  * \b 1.11.0
  *
  * API additions:
@@ -17,6 +17,27 @@
  *
  * This version is not yet released. The following changes are not set in stone yet.
  *
+ * API additions:
+ * \li GSStationList::ValuateCargoRating
+ * \li GSStationList::ValuateCargoWaiting
+ * \li GSStationList::ValuateDistanceManhattanToTile
+ * \li GSTileList::ValuateBuildable
+ * \li GSTileList::ValuateCargoAcceptance
+ * \li GSTileList::ValuateDistanceManhattanToTile
+ * \li GSTileList::ValuateMaxHeight
+ * \li GSTileList::ValuateOwner
+ * \li GSTileList::ValuateSlope
+ * \li GSVehicleList::ValuateAge
+ * \li GSVehicleList::ValuateProfitLastYear
+ * \li GSVehicleList::ValuateProfitThisYear
+ * \li GSVehicleList::ValuateReliability
+ * \li GSVehicleList::ValuateState
+ * \li GSVehicleList::ValuateVehicleType
+ *
+ * Other changes:
+ * \li GSVehicleList_* are now subclasses of GSVehicleList
+ * \li GSStationList_Vehicle is now a subclass of GSStationList
+ *
  * \b 1.11.0
  *
  * API additions:
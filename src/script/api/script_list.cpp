@@ -842,6 +842,17 @@ SQInteger ScriptList::_nexti(HSQUIRRELVM vm)
 	return 1;
 }
 
+void ScriptList::ValuateNative(const std::function<int64(int64)> &valuator)
+{
+	this->modifications++;
+
+	for (ScriptListMap::iterator iter = this->items.begin(); iter != this->items.end(); iter++) {
+		this->SetValue((*iter).first, valuator((*iter).first));
+	}
+
+	ScriptController::DecreaseOps((int)std::min<size_t>(this->items.size() * 5, INT32_MAX));
+}
+
 SQInteger ScriptList::Valuate(HSQUIRRELVM vm)
 {
 	this->modifications++;
@@ -14,6 +14,7 @@
 #include "script_object.hpp"
 #include <map>
 #include <set>
+#include <functional>
 
 class ScriptListSorter;
 
@@ -41,6 +42,14 @@ private:
 	bool initialized;             ///< Whether an iteration has been started
 	int modifications;            ///< Number of modification that has been done. To prevent changing data while valuating.
 
+protected:
+	/**
+	 * Give all items a value computed in C++, without calling back into the script VM for each item.
+	 * The script is charged the same number of ops per item as the fixed per item cost of Valuate.
+	 * @param valuator The function returning the value for a given item.
+	 */
+	void ValuateNative(const std::function<int64(int64)> &valuator);
+
 public:
 	typedef std::set<int64> ScriptItemList;                   ///< The list of items inside the bucket
 	typedef std::map<int64, ScriptItemList> ScriptListBucket; ///< The bucket list per value
@@ -23,7 +23,26 @@ ScriptStationList::ScriptStationList(ScriptStation::StationType station_type)
 	}
 }
 
-ScriptStationList_Vehicle::ScriptStationList_Vehicle(VehicleID vehicle_id)
+ScriptStationList::ScriptStationList()
+{
+}
+
+void ScriptStationList::ValuateCargoWaiting(CargoID cargo_id)
+{
+	this->ValuateNative([cargo_id](int64 station) -> int64 { return ScriptStation::GetCargoWaiting((StationID)station, cargo_id); });
+}
+
+void ScriptStationList::ValuateCargoRating(CargoID cargo_id)
+{
+	this->ValuateNative([cargo_id](int64 station) -> int64 { return ScriptStation::GetCargoRating((StationID)station, cargo_id); });
+}
+
+void ScriptStationList::ValuateDistanceManhattanToTile(TileIndex tile)
+{
+	this->ValuateNative([tile](int64 station) -> int64 { return ScriptStation::GetDistanceManhattanToTile((StationID)station, tile); });
+}
+
+ScriptStationList_Vehicle::ScriptStationList_Vehicle(VehicleID vehicle_id) : ScriptStationList()
 {
 	if (!ScriptVehicle::IsValidVehicle(vehicle_id)) return;
 
@@ -19,11 +19,39 @@
  * @ingroup ScriptList
  */
 class ScriptStationList : public ScriptList {
+protected:
+	/**
+	 * Create an empty list, for subclasses which fill the list themselves.
+	 */
+	ScriptStationList();
+
 public:
 	/**
 	 * @param station_type The type of station to make a list of stations for.
 	 */
 	ScriptStationList(ScriptStation::StationType station_type);
+
+	/**
+	 * Give all stations in the list the value of ScriptStation::GetCargoWaiting.
+	 * @param cargo_id The cargo to get the amount waiting of.
+	 * @note Equivalent to Valuate(ScriptStation.GetCargoWaiting, cargo_id), but evaluated natively,
+	 *  which is much faster for large lists.
+	 */
+	void ValuateCargoWaiting(CargoID cargo_id);
+
+	/**
+	 * Give all stations in the list the value of ScriptStation::GetCargoRating.
+	 * @param cargo_id The cargo to get the rating of.
+	 * @note Equivalent to Valuate(ScriptStation.GetCargoRating, cargo_id), but evaluated natively.
+	 */
+	void ValuateCargoRating(CargoID cargo_id);
+
+	/**
+	 * Give all stations in the list the value of ScriptStation::GetDistanceManhattanToTile.
+	 * @param tile The tile to get the distance to.
+	 * @note Equivalent to Valuate(ScriptStation.GetDistanceManhattanToTile, tile), but evaluated natively.
+	 */
+	void ValuateDistanceManhattanToTile(TileIndex tile);
 };
 
 /**
@@ -276,7 +304,7 @@ public:
  * @api ai game
  * @ingroup ScriptList
  */
-class ScriptStationList_Vehicle : public ScriptList {
+class ScriptStationList_Vehicle : public ScriptStationList {
 public:
 	/**
 	 * @param vehicle_id The vehicle to get the list of stations it has in its orders from.
@@ -10,6 +10,7 @@
 #include "../../stdafx.h"
 #include "script_tilelist.hpp"
 #include "script_industry.hpp"
+#include "script_tile.hpp"
 #include "../../industry.h"
 #include "../../station_base.h"
 
@@ -73,6 +74,36 @@ static void FillIndustryCatchment(const Industry *i, int radius, BitmapTileArea
 	}
 }
 
+void ScriptTileList::ValuateBuildable()
+{
+	this->ValuateNative([](int64 tile) -> int64 { return ScriptTile::IsBuildable((TileIndex)tile) ? 1 : 0; });
+}
+
+void ScriptTileList::ValuateSlope()
+{
+	this->ValuateNative([](int64 tile) -> int64 { return ScriptTile::GetSlope((TileIndex)tile); });
+}
+
+void ScriptTileList::ValuateMaxHeight()
+{
+	this->ValuateNative([](int64 tile) -> int64 { return ScriptTile::GetMaxHeight((TileIndex)tile); });
+}
+
+void ScriptTileList::ValuateOwner()
+{
+	this->ValuateNative([](int64 tile) -> int64 { return ScriptTile::GetOwner((TileIndex)tile); });
+}
+
+void ScriptTileList::ValuateDistanceManhattanToTile(TileIndex tile)
+{
+	this->ValuateNative([tile](int64 item) -> int64 { return ScriptTile::GetDistanceManhattanToTile((TileIndex)item, tile); });
+}
+
+void ScriptTileList::ValuateCargoAcceptance(CargoID cargo_type, int width, int height, int radius)
+{
+	this->ValuateNative([&](int64 tile) -> int64 { return ScriptTile::GetCargoAcceptance((TileIndex)tile, cargo_type, width, height, radius); });
+}
+
 ScriptTileList_IndustryAccepting::ScriptTileList_IndustryAccepting(IndustryID industry_id, int radius)
 {
 	if (!ScriptIndustry::IsValidIndustry(industry_id) || radius <= 0) return;
@@ -51,6 +51,49 @@ public:
 	 * @pre ScriptMap::IsValidTile(tile).
 	 */
 	void RemoveTile(TileIndex tile);
+
+	/**
+	 * Give all tiles in the list the value of ScriptTile::IsBuildable (1 or 0).
+	 * @note Equivalent to Valuate(ScriptTile.IsBuildable), but evaluated natively,
+	 *  which is much faster for large lists.
+	 */
+	void ValuateBuildable();
+
+	/**
+	 * Give all tiles in the list the value of ScriptTile::GetSlope.
+	 * @note Equivalent to Valuate(ScriptTile.GetSlope), but evaluated natively.
+	 */
+	void ValuateSlope();
+
+	/**
+	 * Give all tiles in the list the value of ScriptTile::GetMaxHeight.
+	 * @note Equivalent to Valuate(ScriptTile.GetMaxHeight), but evaluated natively.
+	 */
+	void ValuateMaxHeight();
+
+	/**
+	 * Give all tiles in the list the value of ScriptTile::GetOwner.
+	 * @note Equivalent to Valuate(ScriptTile.GetOwner), but evaluated natively.
+	 */
+	void ValuateOwner();
+
+	/**
+	 * Give all tiles in the list the value of ScriptTile::GetDistanceManhattanToTile.
+	 * @param tile The tile to get the distance to.
+	 * @note Equivalent to Valuate(ScriptTile.GetDistanceManhattanToTile, tile), but evaluated natively.
+	 */
+	void ValuateDistanceManhattanToTile(TileIndex tile);
+
+	/**
+	 * Give all tiles in the list the value of ScriptTile::GetCargoAcceptance.
+	 * @param cargo_type The cargo to check the acceptance of.
+	 * @param width The width of the station.
+	 * @param height The height of the station.
+	 * @param radius The radius of the station.
+	 * @note Equivalent to Valuate(ScriptTile.GetCargoAcceptance, cargo_type, width, height, radius),
+	 *  but evaluated natively.
+	 */
+	void ValuateCargoAcceptance(CargoID cargo_type, int width, int height, int radius);
 };
 
 /**
@@ -18,14 +18,50 @@
 
 #include "../../safeguards.h"
 
-ScriptVehicleList::ScriptVehicleList()
+ScriptVehicleList::ScriptVehicleList(bool populate)
 {
+	if (!populate) return;
+
 	for (const Vehicle *v : Vehicle::Iterate()) {
 		if ((v->owner == ScriptObject::GetCompany() || ScriptObject::GetCompany() == OWNER_DEITY) && (v->IsPrimaryVehicle() || (v->type == VEH_TRAIN && ::Train::From(v)->IsFreeWagon()))) this->AddItem(v->index);
 	}
 }
 
-ScriptVehicleList_Station::ScriptVehicleList_Station(StationID station_id)
+ScriptVehicleList::ScriptVehicleList() : ScriptVehicleList(true)
+{
+}
+
+void ScriptVehicleList::ValuateAge()
+{
+	this->ValuateNative([](int64 vehicle) -> int64 { return ScriptVehicle::GetAge((VehicleID)vehicle); });
+}
+
+void ScriptVehicleList::ValuateState()
+{
+	this->ValuateNative([](int64 vehicle) -> int64 { return ScriptVehicle::GetState((VehicleID)vehicle); });
+}
+
+void ScriptVehicleList::ValuateProfitThisYear()
+{
+	this->ValuateNative([](int64 vehicle) -> int64 { return ScriptVehicle::GetProfitThisYear((VehicleID)vehicle); });
+}
+
+void ScriptVehicleList::ValuateProfitLastYear()
+{
+	this->ValuateNative([](int64 vehicle) -> int64 { return ScriptVehicle::GetProfitLastYear((VehicleID)vehicle); });
+}
+
+void ScriptVehicleList::ValuateReliability()
+{
+	this->ValuateNative([](int64 vehicle) -> int64 { return ScriptVehicle::GetReliability((VehicleID)vehicle); });
+}
+
+void ScriptVehicleList::ValuateVehicleType()
+{
+	this->ValuateNative([](int64 vehicle) -> int64 { return ScriptVehicle::GetVehicleType((VehicleID)vehicle); });
+}
+
+ScriptVehicleList_Station::ScriptVehicleList_Station(StationID station_id) : ScriptVehicleList(false)
 {
 	if (!ScriptBaseStation::IsValidBaseStation(station_id)) return;
 
@@ -41,7 +77,7 @@ ScriptVehicleList_Station::ScriptVehicleList_Station(StationID station_id)
 	}
 }
 
-ScriptVehicleList_Depot::ScriptVehicleList_Depot(TileIndex tile)
+ScriptVehicleList_Depot::ScriptVehicleList_Depot(TileIndex tile) : ScriptVehicleList(false)
 {
 	if (!ScriptMap::IsValidTile(tile)) return;
 
@@ -89,7 +125,7 @@ ScriptVehicleList_Depot::ScriptVehicleList_Depot(TileIndex tile)
 	}
 }
 
-ScriptVehicleList_SharedOrders::ScriptVehicleList_SharedOrders(VehicleID vehicle_id)
+ScriptVehicleList_SharedOrders::ScriptVehicleList_SharedOrders(VehicleID vehicle_id) : ScriptVehicleList(false)
 {
 	if (!ScriptVehicle::IsValidVehicle(vehicle_id)) return;
 
@@ -98,7 +134,7 @@ ScriptVehicleList_SharedOrders::ScriptVehicleList_SharedOrders(VehicleID vehicle
 	}
 }
 
-ScriptVehicleList_Group::ScriptVehicleList_Group(GroupID group_id)
+ScriptVehicleList_Group::ScriptVehicleList_Group(GroupID group_id) : ScriptVehicleList(false)
 {
 	if (!ScriptGroup::IsValidGroup((ScriptGroup::GroupID)group_id)) return;
 
@@ -109,7 +145,7 @@ ScriptVehicleList_Group::ScriptVehicleList_Group(GroupID group_id)
 	}
 }
 
-ScriptVehicleList_DefaultGroup::ScriptVehicleList_DefaultGroup(ScriptVehicle::VehicleType vehicle_type)
+ScriptVehicleList_DefaultGroup::ScriptVehicleList_DefaultGroup(ScriptVehicle::VehicleType vehicle_type) : ScriptVehicleList(false)
 {
 	if (vehicle_type < ScriptVehicle::VT_RAIL || vehicle_type > ScriptVehicle::VT_AIR) return;
 
@@ -19,8 +19,51 @@
  * @ingroup ScriptList
  */
 class ScriptVehicleList : public ScriptList {
+protected:
+	/**
+	 * @param populate Whether to fill the list with all vehicles, or to leave it empty for the subclass to fill.
+	 */
+	ScriptVehicleList(bool populate);
+
 public:
 	ScriptVehicleList();
+
+	/**
+	 * Give all vehicles in the list the value of ScriptVehicle::GetAge.
+	 * @note Equivalent to Valuate(ScriptVehicle.GetAge), but evaluated natively,
+	 *  which is much faster for large lists.
+	 */
+	void ValuateAge();
+
+	/**
+	 * Give all vehicles in the list the value of ScriptVehicle::GetState.
+	 * @note Equivalent to Valuate(ScriptVehicle.GetState), but evaluated natively.
+	 */
+	void ValuateState();
+
+	/**
+	 * Give all vehicles in the list the value of ScriptVehicle::GetProfitThisYear.
+	 * @note Equivalent to Valuate(ScriptVehicle.GetProfitThisYear), but evaluated natively.
+	 */
+	void ValuateProfitThisYear();
+
+	/**
+	 * Give all vehicles in the list the value of ScriptVehicle::GetProfitLastYear.
+	 * @note Equivalent to Valuate(ScriptVehicle.GetProfitLastYear), but evaluated natively.
+	 */
+	void ValuateProfitLastYear();
+
+	/**
+	 * Give all vehicles in the list the value of ScriptVehicle::GetReliability.
+	 * @note Equivalent to Valuate(ScriptVehicle.GetReliability), but evaluated natively.
+	 */
+	void ValuateReliability();
+
+	/**
+	 * Give all vehicles in the list the value of ScriptVehicle::GetVehicleType.
+	 * @note Equivalent to Valuate(ScriptVehicle.GetVehicleType), but evaluated natively.
+	 */
+	void ValuateVehicleType();
 };
 
 /**
@@ -28,7 +71,7 @@ public:
  * @api ai game
  * @ingroup ScriptList
  */
-class ScriptVehicleList_Station : public ScriptList {
+class ScriptVehicleList_Station : public ScriptVehicleList {
 public:
 	/**
 	 * @param station_id The station to get the list of vehicles from, which have orders to it.
@@ -46,7 +89,7 @@ public:
  * @api ai game
  * @ingroup ScriptList
  */
-class ScriptVehicleList_Depot : public ScriptList {
+class ScriptVehicleList_Depot : public ScriptVehicleList {
 public:
 	/**
 	 * @param tile The tile of the depot to get the list of vehicles from, which have orders to it.
@@ -59,7 +102,7 @@ public:
  * @api ai game
  * @ingroup ScriptList
  */
-class ScriptVehicleList_SharedOrders : public ScriptList {
+class ScriptVehicleList_SharedOrders : public ScriptVehicleList {
 public:
 	/**
 	 * @param vehicle_id The vehicle that the rest shared orders with.
@@ -72,7 +115,7 @@ public:
  * @api ai
  * @ingroup ScriptList
  */
-class ScriptVehicleList_Group : public ScriptList {
+class ScriptVehicleList_Group : public ScriptVehicleList {
 public:
 	/**
 	 * @param group_id The ID of the group the vehicles are in.
@@ -85,7 +128,7 @@ public:
  * @api ai
  * @ingroup ScriptList
  */
-class ScriptVehicleList_DefaultGroup : public ScriptList {
+class ScriptVehicleList_DefaultGroup : public ScriptVehicleList {
 public:
 	/**
 	 * @param vehicle_type The VehicleType to get the list of vehicles for.
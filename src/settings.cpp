@@ -1279,6 +1279,12 @@ static bool VehListCargoFilterShownChanged(int32)
 	return true;
 }
 
+static bool TownGrowthFrontierChanged(int32 p1)
+{
+	ClearAllTownGrowthFrontiers();
+	return true;
+}
+
 static bool TownFoundingChanged(int32 p1)
 {
 	if (_game_mode != GM_EDITOR && _settings_game.economy.found_town == TF_FORBIDDEN) {
@@ -611,6 +611,7 @@ struct EconomySettings {
 	bool   multiple_industry_per_town;       ///< allow many industries of the same type per town
 	int8   town_growth_rate;                 ///< town growth rate
 	uint8  town_growth_cargo_transported;    ///< percentage of town growth rate which depends on proportion of transported cargo in the last month
+	bool   town_growth_frontier;             ///< towns grow from a cache of road tiles at their edge, instead of walking the road network from the centre
 	bool   town_zone_calc_mode;              ///< calc mode for town zones
 	uint16 town_zone_0_mult;                 ///< multiplier for the size of town zone 0
 	uint16 town_zone_1_mult;                 ///< multiplier for the size of town zone 1
@@ -21,6 +21,8 @@
 #include "error.h"
 #include "infrastructure_func.h"
 
+#include <unordered_map>
+
 #include "safeguards.h"
 
 /// List of signals dependent upon this one
@@ -34,10 +36,10 @@ static SignalDependencyMap _signal_dependencies;
 static void MarkDependencidesForUpdate(SignalReference sig);
 
 /** these are the maximums used for updating signal blocks */
-static const uint SIG_TBU_SIZE    =  64; ///< number of signals entering to block
-static const uint SIG_TBD_SIZE    = 256; ///< number of intersections - open nodes in current block
-static const uint SIG_GLOB_SIZE   = 128; ///< number of open blocks (block can be opened more times until detected)
-static const uint SIG_GLOB_UPDATE =  64; ///< how many items need to be in _globset to force update
+static const uint SIG_TBU_SIZE    =  4096; ///< number of signals entering to block
+static const uint SIG_TBD_SIZE    = 65536; ///< number of intersections - open nodes in current block
+static const uint SIG_GLOB_SIZE   = 65536; ///< number of open blocks (block can be opened more times until detected)
+static const uint SIG_GLOB_UPDATE =    64; ///< how many items need to be in _globset to force update
 
 static_assert(SIG_GLOB_UPDATE <= SIG_GLOB_SIZE);
 
@@ -58,31 +60,61 @@ static const TrackdirBits _enterdir_to_trackdirbits[DIAGDIR_END] = {
 };
 
 /**
- * Set containing 'items' items of 'tile and Tdir'
- * No tree structure is used because it would cause
- * slowdowns in most usual cases
+ * Set containing up to 'items' items of 'tile and Tdir'
+ * Small sets are searched linearly, as a tree or hash structure would cause
+ * slowdowns in most usual cases. Once the set grows beyond SMALL_SET_INDEX_THRESHOLD items,
+ * a count of each item is also kept so that lookups of items which are not in the set
+ * do not need to scan the whole set, this keeps large junctions from being quadratic.
  */
 template <typename Tdir, uint items>
 struct SmallSet {
 private:
-	uint n;           // actual number of units
+	static const uint SMALL_SET_INDEX_THRESHOLD = 32; ///< Number of items above which the item counts are kept
+
 	bool overflowed;  // did we try to overflow the set?
+	bool indexed;     // are the item counts valid?
 	const char *name; // name, used for debugging purposes...
 
 	/** Element of set */
 	struct SSdata {
 		TileIndex tile;
 		Tdir dir;
-	} data[items];
+	};
+	std::vector<SSdata> data;
+	std::unordered_map<uint64, uint> counts; ///< Number of instances of each item, if indexed
+
+	static inline uint64 Key(TileIndex tile, Tdir dir)
+	{
+		return (((uint64)tile) << 8) | (uint8)dir;
+	}
+
+	/**
+	 * Check via the item counts whether the set may contain the given tile and dir.
+	 * @return false iff the item is definitely not in the set
+	 */
+	inline bool MayBeIn(TileIndex tile, Tdir dir) const
+	{
+		return !this->indexed || this->counts.find(Key(tile, dir)) != this->counts.end();
+	}
+
+	/** Decrement the count of an item which was taken out of the set. */
+	inline void Uncount(TileIndex tile, Tdir dir)
+	{
+		if (!this->indexed) return;
+		auto iter = this->counts.find(Key(tile, dir));
+		if (--iter->second == 0) this->counts.erase(iter);
+	}
 
 public:
 	/** Constructor - just set default values and 'name' */
-	SmallSet(const char *name) : n(0), overflowed(false), name(name) { }
+	SmallSet(const char *name) : overflowed(false), indexed(false), name(name) { }
 
 	/** Reset variables to default values */
 	void Reset()
 	{
-		this->n = 0;
+		this->data.clear();
+		this->counts.clear();
+		this->indexed = false;
 		this->overflowed = false;
 	}
 
@@ -101,7 +133,7 @@ public:
 	 */
 	bool IsEmpty()
 	{
-		return this->n == 0;
+		return this->data.empty();
 	}
 
 	/**
@@ -110,7 +142,7 @@ public:
 	 */
 	bool IsFull()
 	{
-		return this->n == lengthof(data);
+		return this->data.size() == items;
 	}
 
 	/**
@@ -119,7 +151,7 @@ public:
 	 */
 	uint Items()
 	{
-		return this->n;
+		return (uint)this->data.size();
 	}
 
 
@@ -131,9 +163,13 @@ public:
 	 */
 	bool Remove(TileIndex tile, Tdir dir)
 	{
-		for (uint i = 0; i < this->n; i++) {
+		if (!this->MayBeIn(tile, dir)) return false;
+
+		for (uint i = 0; i < this->data.size(); i++) {
 			if (this->data[i].tile == tile && this->data[i].dir == dir) {
-				this->data[i] = this->data[--this->n];
+				this->data[i] = this->data.back();
+				this->data.pop_back();
+				this->Uncount(tile, dir);
 				return true;
 			}
 		}
@@ -149,8 +185,10 @@ public:
 	 */
 	bool IsIn(TileIndex tile, Tdir dir)
 	{
-		for (uint i = 0; i < this->n; i++) {
-			if (this->data[i].tile == tile && this->data[i].dir == dir) return true;
+		if (this->indexed) return this->MayBeIn(tile, dir);
+
+		for (const SSdata &item : this->data) {
+			if (item.tile == tile && item.dir == dir) return true;
 		}
 
 		return false;
@@ -171,9 +209,14 @@ public:
 			return false; // set is full
 		}
 
-		this->data[this->n].tile = tile;
-		this->data[this->n].dir = dir;
-		this->n++;
+		this->data.push_back({ tile, dir });
+
+		if (this->indexed) {
+			this->counts[Key(tile, dir)]++;
+		} else if (this->data.size() > SMALL_SET_INDEX_THRESHOLD) {
+			for (const SSdata &item : this->data) this->counts[Key(item.tile, item.dir)]++;
+			this->indexed = true;
+		}
 
 		return true;
 	}
@@ -186,11 +229,12 @@ public:
 	 */
 	bool Get(TileIndex *tile, Tdir *dir)
 	{
-		if (this->n == 0) return false;
+		if (this->data.empty()) return false;
 
-		this->n--;
-		*tile = this->data[this->n].tile;
-		*dir = this->data[this->n].dir;
+		*tile = this->data.back().tile;
+		*dir = this->data.back().dir;
+		this->data.pop_back();
+		this->Uncount(*tile, *dir);
 
 		return true;
 	}
@@ -293,6 +337,10 @@ struct SigInfo {
 /**
  * Search signal block
  *
+ * The block is flood filled from _tbdset on every update, there is no persistent block graph.
+ * Such a graph would have to be kept in sync by every path which changes track, signal, ownership,
+ * tunnel/bridge or level crossing state, as all of these affect exploration here.
+ *
  * @param owner owner whose signals we are updating
  * @return SigFlags
  */
@@ -163,6 +163,133 @@ static bool _smallmap_industry_highlight_state;
 /** For connecting company ID to position in owner list (small map legend) */
 uint _company_to_list_pos[MAX_COMPANIES];
 
+/**
+ * Cache of the colours of the cells of the smallmap, for one map type, zoom level and alignment of the cells to the tiles.
+ * Cells are invalidated individually when their tiles are marked dirty, and whole chunks of cells are
+ * periodically refreshed, to pick up any changes which are not marked dirty.
+ */
+struct SmallMapColourCache {
+	static const uint MIN_ZOOM = 4;                ///< Minimum zoom level to use the cache at, below this the colours are cheap enough to not need caching.
+	static const uint CHUNK_SHIFT = 6;             ///< Log2 of the width/height of a chunk of cells.
+	static const uint CHUNK_SIZE = 1 << CHUNK_SHIFT;
+	static const uint REFRESH_INTERVAL = 16;       ///< Number of refreshes after which all chunks have been refreshed.
+	static const uint32 UNCACHED = 0xD7D7D7D7;     ///< Colour value of a cell which is not cached.
+
+	int map_type = -1;                             ///< Map type of the cached colours, or -1 if the cache is unused.
+	uint zoom = 0;                                 ///< Zoom level of the cached colours.
+	uint phase_x = 0;                              ///< X coordinate of the origin tile of cells, modulo the zoom level.
+	uint phase_y = 0;                              ///< Y coordinate of the origin tile of cells, modulo the zoom level.
+	bool show_heightmap = false;                   ///< Value of #_smallmap_show_heightmap for the cached colours.
+	byte land_colour = 0;                          ///< Smallmap land colour scheme of the cached colours.
+	uint chunks_x = 0;                             ///< Number of chunks in the X direction.
+	uint refresh_counter = 0;                      ///< Counter used to select the chunks to refresh.
+	std::vector<std::unique_ptr<uint32[]>> chunks; ///< Chunks of cells, allocated on demand.
+
+	void Clear()
+	{
+		this->map_type = -1;
+		this->chunks.clear();
+	}
+
+	/**
+	 * Prepare the cache for drawing.
+	 * @param map_type Map type to draw.
+	 * @param zoom Zoom level to draw at.
+	 * @param tile_x X coordinate of the origin tile of any cell to draw.
+	 * @param tile_y Y coordinate of the origin tile of any cell to draw.
+	 * @return Whether the cache can be used.
+	 */
+	bool Prepare(int map_type, uint zoom, int tile_x, int tile_y)
+	{
+		if (zoom < MIN_ZOOM) {
+			this->Clear();
+			return false;
+		}
+
+		uint phase_x = ((tile_x % (int)zoom) + zoom) % zoom;
+		uint phase_y = ((tile_y % (int)zoom) + zoom) % zoom;
+		if (map_type != this->map_type || zoom != this->zoom || phase_x != this->phase_x || phase_y != this->phase_y ||
+				_smallmap_show_heightmap != this->show_heightmap || _settings_client.gui.smallmap_land_colour != this->land_colour) {
+			this->Clear();
+			this->map_type = map_type;
+			this->zoom = zoom;
+			this->phase_x = phase_x;
+			this->phase_y = phase_y;
+			this->show_heightmap = _smallmap_show_heightmap;
+			this->land_colour = _settings_client.gui.smallmap_land_colour;
+			this->chunks_x = (MapSizeX() / zoom + CHUNK_SIZE) >> CHUNK_SHIFT;
+			uint chunks_y = (MapSizeY() / zoom + CHUNK_SIZE) >> CHUNK_SHIFT;
+			this->chunks.resize(this->chunks_x * chunks_y);
+		}
+		return true;
+	}
+
+	/**
+	 * Get the cached colour of a cell, allocating its chunk if necessary.
+	 * @param xc X coordinate of the origin tile of the cell, within the map.
+	 * @param yc Y coordinate of the origin tile of the cell, within the map.
+	 * @return Reference to the cached colour, which is #UNCACHED if not yet cached.
+	 */
+	uint32 &GetCell(uint xc, uint yc)
+	{
+		uint cx = (xc - this->phase_x) / this->zoom;
+		uint cy = (yc - this->phase_y) / this->zoom;
+		std::unique_ptr<uint32[]> &chunk = this->chunks[(cx >> CHUNK_SHIFT) + ((cy >> CHUNK_SHIFT) * this->chunks_x)];
+		if (!chunk) {
+			chunk.reset(new uint32[CHUNK_SIZE * CHUNK_SIZE]);
+			std::fill_n(chunk.get(), CHUNK_SIZE * CHUNK_SIZE, (uint32)UNCACHED);
+		}
+		return chunk[(cx & (CHUNK_SIZE - 1)) + ((cy & (CHUNK_SIZE - 1)) << CHUNK_SHIFT)];
+	}
+
+	/**
+	 * Invalidate the cell containing a tile.
+	 * @param tile The tile.
+	 */
+	void InvalidateTile(TileIndex tile)
+	{
+		if (this->map_type < 0) return;
+
+		uint x = TileX(tile);
+		uint y = TileY(tile);
+		if (x < this->phase_x || y < this->phase_y) return;
+		uint cx = (x - this->phase_x) / this->zoom;
+		uint cy = (y - this->phase_y) / this->zoom;
+		std::unique_ptr<uint32[]> &chunk = this->chunks[(cx >> CHUNK_SHIFT) + ((cy >> CHUNK_SHIFT) * this->chunks_x)];
+		if (chunk) chunk[(cx & (CHUNK_SIZE - 1)) + ((cy & (CHUNK_SIZE - 1)) << CHUNK_SHIFT)] = UNCACHED;
+	}
+
+	/**
+	 * Free a subset of the chunks, such that every chunk is freed once every #REFRESH_INTERVAL calls.
+	 */
+	void RefreshSome()
+	{
+		this->refresh_counter = (this->refresh_counter + 1) % REFRESH_INTERVAL;
+		for (size_t i = this->refresh_counter; i < this->chunks.size(); i += REFRESH_INTERVAL) {
+			this->chunks[i].reset();
+		}
+	}
+};
+
+static SmallMapColourCache _smallmap_colour_cache;
+
+/**
+ * Invalidate the cached smallmap colour of a tile.
+ * @param tile The tile which has changed.
+ */
+void InvalidateSmallMapTileColour(TileIndex tile)
+{
+	_smallmap_colour_cache.InvalidateTile(tile);
+}
+
+/**
+ * Invalidate all cached smallmap colours.
+ */
+void InvalidateSmallMapColours()
+{
+	_smallmap_colour_cache.Clear();
+}
+
 /**
  * Fills an array for the industries legends.
  */
@@ -743,9 +870,10 @@ inline uint32 SmallMapWindow::GetTileColours(const TileArea &ta) const
  * @param start_pos Position of first pixel to draw.
  * @param end_pos Position of last pixel to draw (exclusive).
  * @param blitter current blitter
+ * @param use_cache Whether to use the smallmap colour cache, see #SmallMapColourCache::Prepare.
  * @note If pixel position is below \c 0, skip drawing.
  */
-void SmallMapWindow::DrawSmallMapColumn(void *dst, uint xc, uint yc, int pitch, int reps, int start_pos, int end_pos, Blitter *blitter) const
+void SmallMapWindow::DrawSmallMapColumn(void *dst, uint xc, uint yc, int pitch, int reps, int start_pos, int end_pos, Blitter *blitter, bool use_cache) const
 {
 	void *dst_ptr_abs_end = blitter->MoveTo(_screen.dst_ptr, 0, _screen.height);
 	uint min_xy = _settings_game.construction.freeform_edges ? 1 : 0;
@@ -758,18 +886,26 @@ void SmallMapWindow::DrawSmallMapColumn(void *dst, uint xc, uint yc, int pitch,
 		if (dst < _screen.dst_ptr) continue;
 		if (dst >= dst_ptr_abs_end) continue;
 
-		/* Construct tilearea covered by (xc, yc, xc + this->zoom, yc + this->zoom) such that it is within min_xy limits. */
-		TileArea ta;
-		if (min_xy == 1 && (xc == 0 || yc == 0)) {
-			if (this->zoom == 1) continue; // The tile area is empty, don't draw anything.
-
-			ta = TileArea(TileXY(std::max(min_xy, xc), std::max(min_xy, yc)), this->zoom - (xc == 0), this->zoom - (yc == 0));
+		uint32 *cached = use_cache ? &_smallmap_colour_cache.GetCell(xc, yc) : nullptr;
+		uint32 val;
+		if (cached != nullptr && *cached != SmallMapColourCache::UNCACHED) {
+			val = *cached;
 		} else {
-			ta = TileArea(TileXY(xc, yc), this->zoom, this->zoom);
+			/* Construct tilearea covered by (xc, yc, xc + this->zoom, yc + this->zoom) such that it is within min_xy limits. */
+			TileArea ta;
+			if (min_xy == 1 && (xc == 0 || yc == 0)) {
+				if (this->zoom == 1) continue; // The tile area is empty, don't draw anything.
+
+				ta = TileArea(TileXY(std::max(min_xy, xc), std::max(min_xy, yc)), this->zoom - (xc == 0), this->zoom - (yc == 0));
+			} else {
+				ta = TileArea(TileXY(xc, yc), this->zoom, this->zoom);
+			}
+			ta.ClampToMap(); // Clamp to map boundaries (may contain MP_VOID tiles!).
+
+			val = this->GetTileColours(ta);
+			if (cached != nullptr) *cached = val;
 		}
-		ta.ClampToMap(); // Clamp to map boundaries (may contain MP_VOID tiles!).
 
-		uint32 val = this->GetTileColours(ta);
 		uint8 *val8 = (uint8 *)&val;
 		int idx = std::max(0, -start_pos);
 		for (int pos = std::max(0, start_pos); pos < end_pos; pos++) {
@@ -895,6 +1031,10 @@ void SmallMapWindow::DrawSmallMap(DrawPixelInfo *dpi, bool draw_indicators) cons
 	int tile_x = this->scroll_x / (int)TILE_SIZE + tile.x;
 	int tile_y = this->scroll_y / (int)TILE_SIZE + tile.y;
 
+	/* The industry highlight blinks, so colours can't be cached while it is active */
+	bool use_cache = this->use_colour_cache && !(this->map_type == SMT_INDUSTRY && _smallmap_industry_highlight != INVALID_INDUSTRYTYPE) &&
+			_smallmap_colour_cache.Prepare(this->map_type, this->zoom, tile_x, tile_y);
+
 	void *ptr = blitter->MoveTo(dpi->dst_ptr, -dx - 4, 0);
 	int x = - dx - 4;
 	int y = 0;
@@ -907,7 +1047,7 @@ void SmallMapWindow::DrawSmallMap(DrawPixelInfo *dpi, bool draw_indicators) cons
 			int end_pos = std::min(dpi->width, x + 4);
 			int reps = (dpi->height - y + 1) / 2; // Number of lines.
 			if (reps > 0) {
-				this->DrawSmallMapColumn(ptr, tile_x, tile_y, dpi->pitch * 2, reps, x, end_pos, blitter);
+				this->DrawSmallMapColumn(ptr, tile_x, tile_y, dpi->pitch * 2, reps, x, end_pos, blitter, use_cache);
 			}
 		}
 
@@ -1009,6 +1149,7 @@ SmallMapWindow::~SmallMapWindow()
 {
 	delete this->overlay;
 	this->BreakIndustryChainLink();
+	InvalidateSmallMapColours();
 }
 
 /**
@@ -1333,6 +1474,9 @@ int SmallMapWindow::GetPositionOnLegend(Point pt)
 
 /* virtual */ void SmallMapWindow::OnClick(Point pt, int widget, int click_count)
 {
+	/* Legend selections change the colours shown */
+	if (widget == WID_SM_LEGEND || widget == WID_SM_ENABLE_ALL || widget == WID_SM_DISABLE_ALL) InvalidateSmallMapColours();
+
 	switch (widget) {
 		case WID_SM_MAP: { // Map window
 			if (click_count > 0) this->mouse_capture_widget = widget;
@@ -1460,6 +1604,8 @@ int SmallMapWindow::GetPositionOnLegend(Point pt)
 {
 	if (!gui_scope) return;
 
+	InvalidateSmallMapColours();
+
 	switch (data) {
 		case 1:
 			/* The owner legend has already been rebuilt. */
@@ -1522,6 +1668,7 @@ int SmallMapWindow::GetPositionOnLegend(Point pt)
 		}
 	}
 	_smallmap_industry_highlight_state = !_smallmap_industry_highlight_state;
+	_smallmap_colour_cache.RefreshSome();
 
 	this->refresh.SetInterval(this->GetRefreshPeriod());
 	this->SetDirty();
@@ -1656,7 +1803,9 @@ void SmallMapWindow::TakeScreenshot()
 	int32 saved_scroll_y = this->scroll_y;
 	int32 saved_subscroll = this->subscroll;
 	this->subscroll = 0;
+	this->use_colour_cache = false;
 	MakeSmallMapScreenshot(width, height, this);
+	this->use_colour_cache = true;
 	this->scroll_x = saved_scroll_x;
 	this->scroll_y = saved_scroll_y;
 	this->subscroll = saved_subscroll;
@@ -40,6 +40,9 @@ static const byte _tiletype_importance[] = {
 /* set up the cargos to be displayed in the smallmap's route legend */
 void BuildLinkStatsLegend();
 
+void InvalidateSmallMapTileColour(TileIndex tile);
+void InvalidateSmallMapColours();
+
 struct TunnelBridgeToMap {
 	TileIndex from_tile;
 	TileIndex to_tile;
@@ -103,6 +106,7 @@ protected:
 	int32 scroll_y;  ///< Vertical world coordinate of the base tile left of the top-left corner of the smallmap display.
 	int32 subscroll; ///< Number of pixels (0..3) between the right end of the base tile and the pixel at the top-left corner of the smallmap display.
 	int zoom;        ///< Zoom level. Bigger number means more zoom-out (further away).
+	bool use_colour_cache = true; ///< Whether to use the smallmap colour cache when drawing, this is not done for screenshots.
 
 	GUITimer refresh; ///< Refresh timer.
 	LinkGraphOverlay *overlay;
@@ -181,7 +185,7 @@ protected:
 	uint PausedAdjustRefreshTimeDelta(uint delta_ms) const;
 
 	void DrawMapIndicators() const;
-	void DrawSmallMapColumn(void *dst, uint xc, uint yc, int pitch, int reps, int start_pos, int end_pos, Blitter *blitter) const;
+	void DrawSmallMapColumn(void *dst, uint xc, uint yc, int pitch, int reps, int start_pos, int end_pos, Blitter *blitter, bool use_cache) const;
 	void DrawVehicles(const DrawPixelInfo *dpi, Blitter *blitter) const;
 	void DrawTowns(const DrawPixelInfo *dpi) const;
 	void DrawSmallMap(DrawPixelInfo *dpi, bool draw_indicators = true) const;
@@ -15,6 +15,9 @@
 #include "core/smallvec_type.hpp"
 #include "date_type.h"
 
+#include <algorithm>
+#include <iterator>
+
 /** Flags of the sort list. */
 enum SortListFlags {
 	VL_NONE       = 0,      ///< no sort
@@ -258,10 +261,43 @@ public:
 
 		const bool desc = (this->flags & VL_DESC) != 0;
 
-		std::sort(std::vector<T>::begin(), std::vector<T>::end(), [&](const T &a, const T &b) { return desc ? compare(b, a) : compare(a, b); });
+		this->SortMostlyOrdered([&](const T &a, const T &b) { return desc ? compare(b, a) : compare(a, b); });
 		return true;
 	}
 
+	/**
+	 * Sort the list, taking advantage of most of it already being in order.
+	 * This is usually the case when resorting, as only the sort keys of some items will have changed.
+	 * Items which are out of order are split off, sorted separately and merged back in,
+	 * so the cost is linear in the size of the list plus the cost of sorting the out of order items.
+	 * @param compare The comparator to sort with.
+	 */
+	template <typename Comp>
+	void SortMostlyOrdered(Comp compare)
+	{
+		std::vector<T> &list = *this;
+		std::vector<T> displaced;
+
+		size_t kept = 0;
+		for (size_t i = 0; i < list.size(); i++) {
+			if (kept > 0 && compare(list[i], list[kept - 1])) {
+				/* Either of the two items may be the one out of order, so split off both */
+				kept--;
+				displaced.push_back(std::move(list[kept]));
+				displaced.push_back(std::move(list[i]));
+			} else {
+				if (kept != i) list[kept] = std::move(list[i]);
+				kept++;
+			}
+		}
+		if (displaced.empty()) return;
+
+		list.erase(list.begin() + kept, list.end());
+		std::sort(displaced.begin(), displaced.end(), compare);
+		list.insert(list.end(), std::make_move_iterator(displaced.begin()), std::make_move_iterator(displaced.end()));
+		std::inplace_merge(list.begin(), list.begin() + kept, list.end(), compare);
+	}
+
 	/**
 	 * Hand the array of sort function pointers to the sort list
 	 *
@@ -20,6 +20,7 @@
 #include "core/mem_func.hpp"
 #include "video/video_driver.hpp"
 #include "scope_info.h"
+#include "memory_accounting.h"
 
 #include "table/sprites.h"
 #include "table/strings.h"
@@ -36,6 +37,7 @@
 uint _sprite_cache_size = 4;
 
 static size_t _spritecache_bytes_used = 0;
+static size_t _spritecache_buffers_used = 0;
 static uint32 _sprite_lru_counter;
 
 PACK_N(class SpriteDataBuffer {
@@ -49,15 +51,18 @@ public:
 	void Allocate(uint32 size)
 	{
 		_spritecache_bytes_used -= this->size;
+		if (this->ptr != nullptr) _spritecache_buffers_used--;
 		free(this->ptr);
 		this->ptr = MallocT<byte>(size);
 		this->size = size;
 		_spritecache_bytes_used += this->size;
+		if (this->ptr != nullptr) _spritecache_buffers_used++;
 	}
 
 	void Clear()
 	{
 		_spritecache_bytes_used -= this->size;
+		if (this->ptr != nullptr) _spritecache_buffers_used--;
 		free(this->ptr);
 		this->ptr = nullptr;
 		this->size = 0;
@@ -754,6 +759,10 @@ static size_t GetSpriteCacheUsage()
 	return _spritecache_bytes_used;
 }
 
+static MemoryAccountingRegistration _spritecache_memory_accounting("Sprite cache", []() -> MemoryAccountingSample {
+	return { GetSpriteCacheUsage() + _spritecache.capacity() * sizeof(SpriteCache), _spritecache_buffers_used };
+});
+
 /**
  * Delete a single entry from the sprite cache.
  * @param item Entry to delete.
@@ -0,0 +1,361 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file state_checksum.cpp Per-subsystem checksums of the game state, for localising desyncs. */
+
+#include "stdafx.h"
+#include "state_checksum.h"
+#include "command_func.h"
+#include "company_base.h"
+#include "cargopacket.h"
+#include "date_func.h"
+#include "debug.h"
+#include "industry.h"
+#include "map_func.h"
+#include "station_base.h"
+#include "town.h"
+#include "train.h"
+#include "vehicle_base.h"
+#include "linkgraph/linkgraph.h"
+#include "network/network.h"
+#include "network/network_func.h"
+#include "string_func.h"
+
+#include <deque>
+
+#include "safeguards.h"
+
+/** Checksum accumulator, FNV-1a over 64 bit words: a single differing input always gives a different result. */
+struct StateChecksumHasher {
+	uint64 state = 0xCBF29CE484222325ULL;
+
+	inline void Add(uint64 input)
+	{
+		this->state = (this->state ^ input) * 0x100000001B3ULL;
+	}
+};
+
+static const char * const _state_checksum_subsystem_names[] = {
+	"map",
+	"vehicles",
+	"stations",
+	"cargo",
+	"link graph",
+	"companies",
+	"towns",
+	"industries",
+};
+static_assert(lengthof(_state_checksum_subsystem_names) == SCS_END);
+
+static const char * const _state_checksum_vehicle_type_names[] = {
+	"train",
+	"road vehicle",
+	"ship",
+	"aircraft",
+	"effect vehicle",
+	"disaster vehicle",
+};
+static_assert(lengthof(_state_checksum_vehicle_type_names) == VEH_END);
+
+/**
+ * Checksum the map arrays, per region.
+ * @param regions Output checksum per region.
+ */
+static void CalculateMapRegionChecksums(uint64 *regions)
+{
+	const uint region_w = MapSizeX() / STATE_CHECKSUM_MAP_REGIONS;
+	const uint region_h = MapSizeY() / STATE_CHECKSUM_MAP_REGIONS;
+
+	StateChecksumHasher hashers[STATE_CHECKSUM_MAP_REGIONS * STATE_CHECKSUM_MAP_REGIONS];
+	for (uint y = 0; y < MapSizeY(); y++) {
+		StateChecksumHasher *row_hashers = hashers + (y / region_h) * STATE_CHECKSUM_MAP_REGIONS;
+		TileIndex tile = TileXY(0, y);
+		for (uint rx = 0; rx < STATE_CHECKSUM_MAP_REGIONS; rx++) {
+			StateChecksumHasher hasher = row_hashers[rx];
+			for (uint x = 0; x < region_w; x++, tile++) {
+				uint64 m;
+				uint32 me;
+				memcpy(&m, &_m[tile], sizeof(m));
+				memcpy(&me, &_me[tile], sizeof(me));
+				hasher.Add(m);
+				hasher.Add(me);
+			}
+			row_hashers[rx] = hasher;
+		}
+	}
+
+	for (uint i = 0; i < lengthof(hashers); i++) regions[i] = hashers[i].state;
+}
+
+/**
+ * Checksum the vehicles, per vehicle type.
+ * @param types Output checksum per vehicle type.
+ */
+static void CalculateVehicleChecksums(uint64 *types)
+{
+	StateChecksumHasher hashers[VEH_END];
+	for (const Vehicle *v : Vehicle::Iterate()) {
+		StateChecksumHasher &hasher = hashers[v->type];
+		hasher.Add((((uint64) v->index) << 32) | v->tile);
+		hasher.Add((((uint64) (uint32) v->x_pos) << 32) | (uint32) v->y_pos);
+		hasher.Add((((uint64) v->z_pos) << 48) | (((uint64) v->direction) << 40) | (((uint64) v->vehstatus) << 32) | (v->cur_speed << 16) | (v->subspeed << 8) | v->progress);
+		hasher.Add((((uint64) v->owner) << 48) | (((uint64) v->cur_real_order_index) << 32) | (v->cur_implicit_order_index << 16) | v->load_unload_ticks);
+		hasher.Add((((uint64) v->reliability) << 32) | (v->breakdown_ctr << 16) | v->breakdown_delay);
+		hasher.Add(v->cargo.TotalCount());
+		hasher.Add(v->current_order.Pack());
+		hasher.Add(v->profit_this_year);
+		if (v->type == VEH_TRAIN) {
+			const Train *t = Train::From(v);
+			hasher.Add((((uint64) t->track) << 32) | t->flags);
+		}
+	}
+
+	for (uint i = 0; i < lengthof(hashers); i++) types[i] = hashers[i].state;
+}
+
+static uint64 CalculateStationChecksum()
+{
+	StateChecksumHasher hasher;
+	for (const Station *st : Station::Iterate()) {
+		hasher.Add((((uint64) st->index) << 32) | st->xy);
+		hasher.Add((((uint64) st->owner) << 32) | (st->facilities << 16) | st->time_since_load << 8 | st->time_since_unload);
+		for (CargoID c = 0; c < NUM_CARGO; c++) {
+			const GoodsEntry &ge = st->goods[c];
+			hasher.Add((((uint64) ge.cargo.TotalCount()) << 32) | (ge.rating << 24) | (ge.status << 16) | (ge.time_since_pickup << 8) | ge.last_speed);
+			hasher.Add((((uint64) ge.link_graph) << 32) | ge.node);
+		}
+	}
+	return hasher.state;
+}
+
+static uint64 CalculateCargoChecksum()
+{
+	StateChecksumHasher hasher;
+	for (const CargoPacket *cp : CargoPacket::Iterate()) {
+		hasher.Add((((uint64) cp->index) << 32) | (cp->Count() << 16) | (cp->DaysInTransit() << 8));
+		hasher.Add((((uint64) cp->SourceStation()) << 32) | cp->SourceStationXY());
+		hasher.Add(cp->LoadedAtXY());
+		hasher.Add(cp->FeederShare());
+	}
+	return hasher.state;
+}
+
+static uint64 CalculateLinkGraphChecksum()
+{
+	StateChecksumHasher hasher;
+	for (const LinkGraph *lg : LinkGraph::Iterate()) {
+		hasher.Add((((uint64) lg->index) << 32) | (lg->Cargo() << 24) | lg->Size());
+		hasher.Add(lg->LastCompression());
+		for (NodeID node = 0; node < lg->Size(); node++) {
+			LinkGraph::ConstNode from = (*lg)[node];
+			hasher.Add((((uint64) from.Station()) << 32) | node);
+			hasher.Add((((uint64) from.Supply()) << 32) | from.Demand());
+			for (LinkGraph::ConstEdgeIterator it = from.Begin(); it != from.End(); ++it) {
+				hasher.Add(it->first);
+				hasher.Add((((uint64) it->second.Capacity()) << 32) | it->second.Usage());
+			}
+		}
+	}
+	return hasher.state;
+}
+
+static uint64 CalculateCompanyChecksum()
+{
+	StateChecksumHasher hasher;
+	for (const Company *c : Company::Iterate()) {
+		hasher.Add((((uint64) c->index) << 32) | (c->money_fraction << 8) | c->months_of_bankruptcy);
+		hasher.Add(c->money);
+		hasher.Add(c->current_loan);
+	}
+	return hasher.state;
+}
+
+static uint64 CalculateTownChecksum()
+{
+	StateChecksumHasher hasher;
+	for (const Town *t : Town::Iterate()) {
+		hasher.Add((((uint64) t->index) << 32) | t->xy);
+		hasher.Add((((uint64) t->cache.population) << 32) | t->cache.num_houses);
+		hasher.Add((((uint64) t->GetGrowCounter()) << 32) | (t->growth_rate << 8) | t->flags);
+	}
+	return hasher.state;
+}
+
+static uint64 CalculateIndustryChecksum()
+{
+	StateChecksumHasher hasher;
+	for (const Industry *ind : Industry::Iterate()) {
+		hasher.Add((((uint64) ind->index) << 32) | ind->location.tile);
+		hasher.Add((((uint64) ind->type) << 48) | (((uint64) ind->owner) << 40) | (((uint64) ind->prod_level) << 32) | (ind->counter << 16) | ind->random);
+		hasher.Add(ind->last_prod_year);
+		for (uint i = 0; i < INDUSTRY_NUM_OUTPUTS; i++) {
+			hasher.Add((((uint64) ind->produced_cargo_waiting[i]) << 32) | ind->production_rate[i]);
+		}
+		for (uint i = 0; i < INDUSTRY_NUM_INPUTS; i++) {
+			hasher.Add(ind->incoming_cargo_waiting[i]);
+		}
+	}
+	return hasher.state;
+}
+
+/** Calculate all of the checksums from the current game state. */
+void StateChecksumTree::Calculate()
+{
+	this->date = _date;
+	this->date_fract = _date_fract;
+	this->tick_skip_counter = _tick_skip_counter;
+
+	CalculateMapRegionChecksums(this->map_regions);
+	CalculateVehicleChecksums(this->vehicle_types);
+
+	StateChecksumHasher map_hasher;
+	for (uint64 region : this->map_regions) map_hasher.Add(region);
+	this->subsystems[SCS_MAP] = map_hasher.state;
+
+	StateChecksumHasher vehicle_hasher;
+	for (uint64 type : this->vehicle_types) vehicle_hasher.Add(type);
+	this->subsystems[SCS_VEHICLES] = vehicle_hasher.state;
+
+	this->subsystems[SCS_STATIONS] = CalculateStationChecksum();
+	this->subsystems[SCS_CARGO] = CalculateCargoChecksum();
+	this->subsystems[SCS_LINKGRAPH] = CalculateLinkGraphChecksum();
+	this->subsystems[SCS_COMPANIES] = CalculateCompanyChecksum();
+	this->subsystems[SCS_TOWNS] = CalculateTownChecksum();
+	this->subsystems[SCS_INDUSTRIES] = CalculateIndustryChecksum();
+
+	StateChecksumHasher root_hasher;
+	for (uint64 subsystem : this->subsystems) root_hasher.Add(subsystem);
+	this->root = root_hasher.state;
+}
+
+/**
+ * Compare against the checksums of another party, descending only into subsystems which differ.
+ * @param other Checksums of the other party, for the same tick.
+ * @param mismatch Called with a description of each differing checksum.
+ * @return Number of differing checksums.
+ */
+uint StateChecksumTree::Compare(const StateChecksumTree &other, std::function<void(const char *)> mismatch) const
+{
+	if (this->root == other.root) return 0;
+
+	char buffer[256];
+	uint count = 0;
+	auto report = [&](uint64 a, uint64 b) {
+		char *p = buffer + strlen(buffer);
+		seprintf(p, lastof(buffer), ": " OTTD_PRINTFHEX64PAD " != " OTTD_PRINTFHEX64PAD, a, b);
+		mismatch(buffer);
+		count++;
+	};
+
+	for (uint i = 0; i < SCS_END; i++) {
+		if (this->subsystems[i] == other.subsystems[i]) continue;
+		seprintf(buffer, lastof(buffer), "state checksum mismatch: %s", _state_checksum_subsystem_names[i]);
+		report(this->subsystems[i], other.subsystems[i]);
+
+		if (i == SCS_MAP) {
+			const uint region_w = MapSizeX() / STATE_CHECKSUM_MAP_REGIONS;
+			const uint region_h = MapSizeY() / STATE_CHECKSUM_MAP_REGIONS;
+			for (uint r = 0; r < lengthof(this->map_regions); r++) {
+				if (this->map_regions[r] == other.map_regions[r]) continue;
+				const uint x = (r % STATE_CHECKSUM_MAP_REGIONS) * region_w;
+				const uint y = (r / STATE_CHECKSUM_MAP_REGIONS) * region_h;
+				seprintf(buffer, lastof(buffer), "state checksum mismatch: map region %u (x: %u - %u, y: %u - %u)", r, x, x + region_w - 1, y, y + region_h - 1);
+				report(this->map_regions[r], other.map_regions[r]);
+			}
+		} else if (i == SCS_VEHICLES) {
+			for (uint t = 0; t < VEH_END; t++) {
+				if (this->vehicle_types[t] == other.vehicle_types[t]) continue;
+				seprintf(buffer, lastof(buffer), "state checksum mismatch: vehicles: %s", _state_checksum_vehicle_type_names[t]);
+				report(this->vehicle_types[t], other.vehicle_types[t]);
+			}
+		}
+	}
+	return count;
+}
+
+/**
+ * Dump the checksum tree.
+ * @param buffer Output buffer.
+ * @param last End of the output buffer.
+ * @return End of the written output.
+ */
+char *StateChecksumTree::Dump(char *buffer, const char *last) const
+{
+	YearMonthDay ymd;
+	ConvertDateToYMD(this->date, &ymd);
+	buffer += seprintf(buffer, last, "State checksums: %4i-%02i-%02i, %2i, %3i\n", ymd.year, ymd.month + 1, ymd.day, this->date_fract, this->tick_skip_counter);
+	buffer += seprintf(buffer, last, "root: " OTTD_PRINTFHEX64PAD "\n", this->root);
+	for (uint i = 0; i < SCS_END; i++) {
+		buffer += seprintf(buffer, last, "  %s: " OTTD_PRINTFHEX64PAD "\n", _state_checksum_subsystem_names[i], this->subsystems[i]);
+		if (i == SCS_MAP) {
+			for (uint r = 0; r < lengthof(this->map_regions); r++) {
+				buffer += seprintf(buffer, last, "    region %u, %u: " OTTD_PRINTFHEX64PAD "\n", r % STATE_CHECKSUM_MAP_REGIONS, r / STATE_CHECKSUM_MAP_REGIONS, this->map_regions[r]);
+			}
+		} else if (i == SCS_VEHICLES) {
+			for (uint t = 0; t < VEH_END; t++) {
+				buffer += seprintf(buffer, last, "    %s: " OTTD_PRINTFHEX64PAD "\n", _state_checksum_vehicle_type_names[t], this->vehicle_types[t]);
+			}
+		}
+	}
+	return buffer;
+}
+
+static std::deque<StateChecksumTree> _recorded_state_checksums; ///< Recently calculated checksums, for comparing against those reported by clients.
+
+/**
+ * Keep checksums calculated by the server, so that those reported later by the clients can be compared against them.
+ * @param tree The checksums to keep.
+ */
+void RecordStateChecksumTree(const StateChecksumTree &tree)
+{
+	if (!_recorded_state_checksums.empty() && _recorded_state_checksums.back().IsSameTick(tree)) {
+		_recorded_state_checksums.back() = tree;
+		return;
+	}
+	if (_recorded_state_checksums.size() >= 16) _recorded_state_checksums.pop_front();
+	_recorded_state_checksums.push_back(tree);
+}
+
+/**
+ * Find recorded checksums of the same tick as the given checksums.
+ * @param tree The checksums to find the counterpart of.
+ * @return The recorded checksums, or nullptr if there are none for that tick.
+ */
+const StateChecksumTree *FindRecordedStateChecksumTree(const StateChecksumTree &tree)
+{
+	for (const StateChecksumTree &recorded : _recorded_state_checksums) {
+		if (recorded.IsSameTick(tree)) return &recorded;
+	}
+	return nullptr;
+}
+
+/**
+ * Calculate the state checksums at the same tick on the server and all clients,
+ * clients report theirs to the server which compares them against its own.
+ * @param tile unused
+ * @param flags operation to perform
+ * @param p1 unused
+ * @param p2 unused
+ * @param text unused
+ * @return the cost of this operation or an error
+ */
+CommandCost CmdStateChecksums(TileIndex tile, DoCommandFlag flags, uint32 p1, uint32 p2, const char *text)
+{
+	if (flags & DC_EXEC) {
+		StateChecksumTree tree;
+		tree.Calculate();
+		DEBUG(desync, 1, "State checksums: date{%08x; %02x; %02x}; root: " OTTD_PRINTFHEX64, _date, _date_fract, _tick_skip_counter, tree.root);
+
+		if (_networking && !_network_server) {
+			NetworkClientSendStateChecksums(tree);
+		} else {
+			RecordStateChecksumTree(tree);
+		}
+	}
+
+	return CommandCost();
+}
@@ -0,0 +1,86 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file state_checksum.h Per-subsystem checksums of the game state, for localising desyncs. */
+
+#ifndef STATE_CHECKSUM_H
+#define STATE_CHECKSUM_H
+
+#include "date_type.h"
+#include "vehicle_type.h"
+#include <functional>
+
+/** Subsystems of the game state which are checksummed separately. */
+enum StateChecksumSubsystem {
+	SCS_MAP,                     ///< Map arrays, further split by map region.
+	SCS_VEHICLES,                ///< Vehicles, further split by vehicle type.
+	SCS_STATIONS,                ///< Stations and their goods entries.
+	SCS_CARGO,                   ///< Cargo packets.
+	SCS_LINKGRAPH,               ///< Link graphs.
+	SCS_COMPANIES,               ///< Company finances.
+	SCS_TOWNS,                   ///< Towns.
+	SCS_INDUSTRIES,              ///< Industries.
+	SCS_END,
+};
+
+static const uint STATE_CHECKSUM_MAP_REGIONS = 8; ///< Number of map regions the map checksum is split into along each axis.
+
+/**
+ * Checksums of the game state, as a tree: the root combines one checksum per subsystem,
+ * and the map and vehicle checksums combine one checksum per map region and per vehicle type.
+ * Comparing the trees of two parties at the same tick narrows a desync down to a subsystem,
+ * and for the map to a region.
+ */
+struct StateChecksumTree {
+	/** Number of checksums in the tree, see GetNode. */
+	static const uint NODE_COUNT = 1 + SCS_END + STATE_CHECKSUM_MAP_REGIONS * STATE_CHECKSUM_MAP_REGIONS + VEH_END;
+
+	Date date;                   ///< Date of the tick the checksums were calculated at.
+	DateFract date_fract;        ///< Date fraction of the tick the checksums were calculated at.
+	uint8 tick_skip_counter;     ///< Tick skip counter of the tick the checksums were calculated at.
+
+	uint64 root;                                                                   ///< Checksum of all subsystem checksums.
+	uint64 subsystems[SCS_END];                                                    ///< Checksum per subsystem.
+	uint64 map_regions[STATE_CHECKSUM_MAP_REGIONS * STATE_CHECKSUM_MAP_REGIONS];   ///< Checksum per map region, row-major.
+	uint64 vehicle_types[VEH_END];                                                 ///< Checksum per vehicle type.
+
+	void Calculate();
+
+	/**
+	 * Get a checksum of the tree by its index, for transferring the tree.
+	 * @param index Index of the checksum, less than #NODE_COUNT.
+	 * @return The checksum.
+	 */
+	uint64 &GetNode(uint index)
+	{
+		if (index == 0) return this->root;
+		index--;
+		if (index < SCS_END) return this->subsystems[index];
+		index -= SCS_END;
+		if (index < lengthof(this->map_regions)) return this->map_regions[index];
+		index -= lengthof(this->map_regions);
+		return this->vehicle_types[index];
+	}
+
+	uint64 GetNode(uint index) const
+	{
+		return const_cast<StateChecksumTree *>(this)->GetNode(index);
+	}
+
+	bool IsSameTick(const StateChecksumTree &other) const
+	{
+		return this->date == other.date && this->date_fract == other.date_fract && this->tick_skip_counter == other.tick_skip_counter;
+	}
+
+	uint Compare(const StateChecksumTree &other, std::function<void(const char *)> mismatch) const;
+	char *Dump(char *buffer, const char *last) const;
+};
+
+void RecordStateChecksumTree(const StateChecksumTree &tree);
+const StateChecksumTree *FindRecordedStateChecksumTree(const StateChecksumTree &tree);
+
+#endif /* STATE_CHECKSUM_H */
@@ -20,6 +20,7 @@
 #include "vehiclelist.h"
 #include "core/pool_func.hpp"
 #include "station_base.h"
+#include "waypoint_base.h"
 #include "station_kdtree.h"
 #include "roadstop_base.h"
 #include "industry.h"
@@ -180,6 +181,15 @@ void BaseStation::PostDestructor(size_t index)
 	InvalidateWindowData(WC_SELECT_STATION, 0, 0);
 }
 
+/**
+ * Size of the slots of the station pool, which must fit both stations and waypoints.
+ * @return size of the largest station type
+ */
+size_t BaseStation::GetPoolSlotSize()
+{
+	return std::max(sizeof(Station), sizeof(Waypoint));
+}
+
 /**
  * Get the primary road stop (the first road stop) that the given vehicle can load/unload.
  * @param v the vehicle to get the first road stop for
@@ -398,6 +408,7 @@ void Station::AddIndustryToDeliver(Industry *ind)
  */
 void Station::RemoveFromAllNearbyLists()
 {
+	InvalidateAllIndustryStationCandidates();
 	for (Town *t : Town::Iterate()) { t->stations_near.erase(this); }
 	for (Industry *i : Industry::Iterate()) { i->stations_near.erase(this); }
 }
@@ -419,61 +430,76 @@ bool Station::CatchmentCoversTown(TownID t) const
 }
 
 /**
- * Recompute tiles covered in our catchment area.
- * This will additionally recompute nearby towns and industries.
+ * Calculate the tiles covered by our catchment area, without updating the cached catchment.
+ * @param[out] catchment_tiles Tiles covered by the catchment area.
+ * @param[out] station_tiles Number of tiles of this station.
  */
-void Station::RecomputeCatchment(bool no_clear_nearby_lists)
+void Station::CalculateCatchment(BitmapTileArea &catchment_tiles, uint &station_tiles) const
 {
-	this->industries_near.clear();
-	if (!no_clear_nearby_lists) this->RemoveFromAllNearbyLists();
+	station_tiles = 0;
 
 	if (this->rect.IsEmpty()) {
-		this->catchment_tiles.Reset();
+		catchment_tiles.Reset();
 		return;
 	}
 
-	if (!_settings_game.station.serve_neutral_industries && this->industry != nullptr) {
-		/* Station is associated with an industry, so we only need to deliver to that industry. */
-		this->catchment_tiles.Initialize(this->industry->location);
+	/* A station associated with an industry only needs to deliver to that industry. */
+	const bool neutral = !_settings_game.station.serve_neutral_industries && this->industry != nullptr;
+	if (neutral) {
+		catchment_tiles.Initialize(this->industry->location);
 		TILE_AREA_LOOP(tile, this->industry->location) {
 			if (IsTileType(tile, MP_INDUSTRY) && GetIndustryIndex(tile) == this->industry->index) {
-				this->catchment_tiles.SetTile(tile);
+				catchment_tiles.SetTile(tile);
 			}
 		}
-		/* The industry's stations_near may have been computed before its neutral station was built so clear and re-add here. */
-		for (Station *st : this->industry->stations_near) {
-			st->industries_near.erase(this->industry);
-		}
-		this->industry->stations_near.clear();
-		this->industry->stations_near.insert(this);
-		this->industries_near.insert(this->industry);
-
-		/* Loop finding all station tiles */
-		TileArea ta(TileXY(this->rect.left, this->rect.top), TileXY(this->rect.right, this->rect.bottom));
-		this->station_tiles = 0;
-		TILE_AREA_LOOP(tile, ta) {
-			if (!IsTileType(tile, MP_STATION) || GetStationIndex(tile) != this->index) continue;
-			this->station_tiles++;
-		}
-		return;
+	} else {
+		catchment_tiles.Initialize(GetCatchmentRect());
 	}
 
-	this->catchment_tiles.Initialize(GetCatchmentRect());
-
 	/* Loop finding all station tiles */
 	TileArea ta(TileXY(this->rect.left, this->rect.top), TileXY(this->rect.right, this->rect.bottom));
-	this->station_tiles = 0;
 	TILE_AREA_LOOP(tile, ta) {
 		if (!IsTileType(tile, MP_STATION) || GetStationIndex(tile) != this->index) continue;
 
-		this->station_tiles++;
+		station_tiles++;
+		if (neutral) continue;
 
 		uint r = GetTileCatchmentRadius(tile, this);
 		if (r == CA_NONE) continue;
 
 		/* This tile sub-loop doesn't need to test any tiles, they are simply added to the catchment set. */
 		TileArea ta2 = TileArea(tile, 1, 1).Expand(r);
-		TILE_AREA_LOOP(tile2, ta2) this->catchment_tiles.SetTile(tile2);
+		TILE_AREA_LOOP(tile2, ta2) catchment_tiles.SetTile(tile2);
+	}
+}
+
+/**
+ * Recompute tiles covered in our catchment area.
+ * This will additionally recompute nearby towns and industries.
+ */
+void Station::RecomputeCatchment(bool no_clear_nearby_lists)
+{
+	this->industries_near.clear();
+	this->catchment_acceptance_valid = false;
+	InvalidateAllIndustryStationCandidates();
+	if (!no_clear_nearby_lists) this->RemoveFromAllNearbyLists();
+
+	if (this->rect.IsEmpty()) {
+		this->catchment_tiles.Reset();
+		return;
+	}
+
+	this->CalculateCatchment(this->catchment_tiles, this->station_tiles);
+
+	if (!_settings_game.station.serve_neutral_industries && this->industry != nullptr) {
+		/* The industry's stations_near may have been computed before its neutral station was built so clear and re-add here. */
+		for (Station *st : this->industry->stations_near) {
+			st->industries_near.erase(this->industry);
+		}
+		this->industry->stations_near.clear();
+		this->industry->stations_near.insert(this);
+		this->industries_near.insert(this->industry);
+		return;
 	}
 
 	/* Search catchment tiles for towns and industries */
@@ -27,7 +27,7 @@
 #include <functional>
 #include <algorithm>
 
-typedef Pool<BaseStation, StationID, 32, 64000> StationPool;
+typedef Pool<BaseStation, StationID, 32, 64000, PT_NORMAL, false, true, true> StationPool;
 extern StationPool _station_pool;
 
 static const byte INITIAL_STATION_RATING = 175;
@@ -168,6 +168,13 @@ public:
 
 	inline size_t size() const { return this->count; }
 	inline bool empty() const { return this->count == 0; }
+
+	/**
+	 * Get the memory allocated for the shares, when they don't fit inline.
+	 * @return Size in bytes.
+	 */
+	inline size_t GetAllocatedMemory() const { return this->inline_mode() ? 0 : this->storage.ptr_shares.elem_capacity * sizeof(ShareEntry); }
+
 	inline iterator begin() { return this->data(); }
 	inline const_iterator begin() const { return this->data(); }
 	inline iterator end() { return this->data() + this->count; }
@@ -436,6 +443,19 @@ public:
 		return this->flows_storage.size();
 	}
 
+	/**
+	 * Get the memory allocated for the flows, including their shares.
+	 * @return Size in bytes.
+	 */
+	size_t GetAllocatedMemory() const
+	{
+		size_t bytes = this->flows_storage.capacity() * sizeof(FlowStat) + this->flows_index.bytes_used();
+		for (const FlowStat &flow : this->flows_storage) {
+			bytes += flow.GetAllocatedMemory();
+		}
+		return bytes;
+	}
+
 	void erase(StationID st)
 	{
 		auto iter = this->flows_index.find(st);
@@ -796,6 +816,11 @@ public:
 	BitmapTileArea catchment_tiles; ///< NOSAVE: Set of individual tiles covered by catchment area
 	uint station_tiles;             ///< NOSAVE: Count of station tiles owned by this station
 
+	CargoArray catchment_static_acceptance;           ///< NOSAVE: Summed acceptance of the static acceptance tiles in the catchment area, if catchment_acceptance_valid
+	uint16 catchment_static_always_accepted[NUM_CARGO]; ///< NOSAVE: Number of static acceptance tiles in the catchment area which always accept each cargo type, if catchment_acceptance_valid
+	std::vector<TileIndex> catchment_dynamic_tiles;   ///< NOSAVE: Sorted catchment tiles whose acceptance is evaluated on each acceptance update, if catchment_acceptance_valid
+	bool catchment_acceptance_valid;                  ///< NOSAVE: Whether the catchment acceptance cache is valid, it is rebuilt from the catchment tiles when not
+
 	StationHadVehicleOfType had_vehicle_of_type;
 
 	byte time_since_load;
@@ -823,6 +848,7 @@ public:
 
 	uint GetPlatformLength(TileIndex tile, DiagDirection dir) const override;
 	uint GetPlatformLength(TileIndex tile) const override;
+	void CalculateCatchment(BitmapTileArea &catchment_tiles, uint &station_tiles) const;
 	void RecomputeCatchment(bool no_clear_nearby_lists = false);
 	static void RecomputeCatchmentForAll();
 
@@ -51,6 +51,7 @@
 #include "newgrf_airporttiles.h"
 #include "order_backup.h"
 #include "newgrf_house.h"
+#include "object_map.h"
 #include "company_gui.h"
 #include "linkgraph/linkgraph_base.h"
 #include "linkgraph/refresh.h"
@@ -562,18 +563,197 @@ CargoArray GetAcceptanceAroundTiles(TileIndex tile, int w, int h, int rad, Cargo
 	return acceptance;
 }
 
+/** How a tile contributes to the acceptance cache of the stations whose catchment covers it. */
+enum StationAcceptanceTileType {
+	SATT_NONE,    ///< Tile does not accept any cargo.
+	SATT_STATIC,  ///< Tile acceptance only changes when the tile is added or removed, it is summed into the cache.
+	SATT_DYNAMIC, ///< Tile acceptance may change at any time, it is evaluated on each acceptance update.
+};
+
+/**
+ * Classify how a tile contributes to the acceptance of stations.
+ * @param tile Tile to classify.
+ * @return The contribution type of the tile.
+ */
+static StationAcceptanceTileType GetStationAcceptanceTileType(TileIndex tile)
+{
+	switch (GetTileType(tile)) {
+		case MP_HOUSE: {
+			const HouseSpec *hs = HouseSpec::Get(GetHouseType(tile));
+			if (HasBit(hs->callback_mask, CBM_HOUSE_ACCEPT_CARGO) || HasBit(hs->callback_mask, CBM_HOUSE_CARGO_ACCEPTANCE)) return SATT_DYNAMIC;
+			return SATT_STATIC;
+		}
+
+		case MP_INDUSTRY:
+			/* Industry tile graphics, and with them the acceptance, can change without the tile being rebuilt. */
+			return SATT_DYNAMIC;
+
+		case MP_OBJECT:
+			/* HQ acceptance depends on the HQ size. */
+			return IsObjectType(tile, OBJECT_HQ) ? SATT_DYNAMIC : SATT_NONE;
+
+		default:
+			return SATT_NONE;
+	}
+}
+
+/**
+ * Add or subtract the acceptance of a static acceptance tile to/from the acceptance cache of a station.
+ * @param st Station to update.
+ * @param acceptance Acceptance of the tile.
+ * @param always_accepted Always accepted cargo types of the tile.
+ * @param add True to add the tile, false to subtract it.
+ */
+static void AdjustStationStaticAcceptance(Station *st, const CargoArray &acceptance, CargoTypes always_accepted, bool add)
+{
+	for (CargoID c = 0; c < NUM_CARGO; c++) {
+		if (add) {
+			st->catchment_static_acceptance[c] += acceptance[c];
+			if (HasBit(always_accepted, c)) st->catchment_static_always_accepted[c]++;
+		} else {
+			st->catchment_static_acceptance[c] -= acceptance[c];
+			if (HasBit(always_accepted, c)) st->catchment_static_always_accepted[c]--;
+		}
+	}
+}
+
+/**
+ * Rebuild the acceptance cache of a station from its catchment tiles.
+ * @param st Station to rebuild the cache of.
+ */
+static void RebuildStationAcceptanceCache(Station *st)
+{
+	st->catchment_static_acceptance.Clear();
+	MemSetT(st->catchment_static_always_accepted, 0, lengthof(st->catchment_static_always_accepted));
+	st->catchment_dynamic_tiles.clear();
+
+	BitmapTileIterator it(st->catchment_tiles);
+	for (TileIndex tile = it; tile != INVALID_TILE; tile = ++it) {
+		switch (GetStationAcceptanceTileType(tile)) {
+			case SATT_STATIC: {
+				CargoArray acceptance;
+				CargoTypes always_accepted = 0;
+				AddAcceptedCargo(tile, acceptance, &always_accepted);
+				AdjustStationStaticAcceptance(st, acceptance, always_accepted, true);
+				break;
+			}
+
+			case SATT_DYNAMIC:
+				/* The bitmap is iterated in tile index order, so this stays sorted. */
+				st->catchment_dynamic_tiles.push_back(tile);
+				break;
+
+			default:
+				break;
+		}
+	}
+
+	st->catchment_acceptance_valid = true;
+}
+
+/**
+ * Update the acceptance caches of all stations whose catchment covers a tile which is being added or removed.
+ * @param tile Tile being added or removed.
+ * @param add True if the tile has just been added, false if it is about to be removed.
+ */
+static void UpdateStationAcceptanceCachesForTile(TileIndex tile, bool add)
+{
+	if (Station::GetNumItems() == 0) return;
+
+	const StationAcceptanceTileType type = GetStationAcceptanceTileType(tile);
+	if (type == SATT_NONE) return;
+
+	CargoArray acceptance;
+	CargoTypes always_accepted = 0;
+	if (type == SATT_STATIC) AddAcceptedCargo(tile, acceptance, &always_accepted);
+
+	auto update_station = [&](Station *st) {
+		if (!st->catchment_acceptance_valid || !st->TileIsInCatchment(tile)) return;
+
+		if (type == SATT_STATIC) {
+			AdjustStationStaticAcceptance(st, acceptance, always_accepted, add);
+		} else {
+			auto iter = std::lower_bound(st->catchment_dynamic_tiles.begin(), st->catchment_dynamic_tiles.end(), tile);
+			if (add) {
+				if (iter == st->catchment_dynamic_tiles.end() || *iter != tile) st->catchment_dynamic_tiles.insert(iter, tile);
+			} else {
+				if (iter != st->catchment_dynamic_tiles.end() && *iter == tile) st->catchment_dynamic_tiles.erase(iter);
+			}
+		}
+	};
+
+	/* The station sign is kept inside the station rect, so the tiles of any station whose catchment
+	 * covers this tile are at most the station spread from its sign, plus the catchment radius.
+	 * The spread setting may have been lowered since larger stations were built, so use its maximum. */
+	const bool neutral_stations = !_settings_game.station.serve_neutral_industries;
+	uint max_c = _settings_game.station.modified_catchment ? MAX_CATCHMENT : CA_UNMODIFIED;
+	max_c += _settings_game.station.catchment_increase;
+	ForAllStationsRadius(tile, MAX_STATION_SPREAD + max_c, [&](Station *st) {
+		if (neutral_stations && st->industry != nullptr) return;
+		update_station(st);
+	});
+
+	/* The catchment of a neutral station only covers its industry, which is not necessarily near the station sign. */
+	if (neutral_stations && IsTileType(tile, MP_INDUSTRY)) {
+		Station *st = Industry::GetByTile(tile)->neutral_station;
+		if (st != nullptr) update_station(st);
+	}
+}
+
+/**
+ * Update the station acceptance caches for a house, industry or object tile which has just been added to the map.
+ * @param tile The new tile.
+ */
+void AddTileToStationAcceptanceCaches(TileIndex tile)
+{
+	UpdateStationAcceptanceCachesForTile(tile, true);
+}
+
+/**
+ * Update the station acceptance caches for a house, industry or object tile which is about to be removed from the map.
+ * @param tile The tile to be removed, this must still be intact.
+ */
+void RemoveTileFromStationAcceptanceCaches(TileIndex tile)
+{
+	UpdateStationAcceptanceCachesForTile(tile, false);
+}
+
+/**
+ * Invalidate the acceptance caches of all stations, e.g. after the house specs changed.
+ */
+void InvalidateAllStationAcceptanceCaches()
+{
+	for (Station *st : Station::Iterate()) st->catchment_acceptance_valid = false;
+}
+
 /**
  * Get the acceptance of cargoes around the station in.
  * @param st Station to get acceptance of.
  * @param always_accepted bitmask of cargo accepted by houses and headquarters; can be nullptr
+ * @param use_cache Whether to use (and if necessary rebuild) the station acceptance cache, instead of evaluating all catchment tiles.
  */
-static CargoArray GetAcceptanceAroundStation(const Station *st, CargoTypes *always_accepted)
+CargoArray GetAcceptanceAroundStation(Station *st, CargoTypes *always_accepted, bool use_cache)
 {
 	CargoArray acceptance;
 	if (always_accepted != nullptr) *always_accepted = 0;
 
-	BitmapTileIterator it(st->catchment_tiles);
-	for (TileIndex tile = it; tile != INVALID_TILE; tile = ++it) {
+	if (!use_cache) {
+		BitmapTileIterator it(st->catchment_tiles);
+		for (TileIndex tile = it; tile != INVALID_TILE; tile = ++it) {
+			AddAcceptedCargo(tile, acceptance, always_accepted);
+		}
+		return acceptance;
+	}
+
+	if (!st->catchment_acceptance_valid) RebuildStationAcceptanceCache(st);
+
+	acceptance = st->catchment_static_acceptance;
+	if (always_accepted != nullptr) {
+		for (CargoID c = 0; c < NUM_CARGO; c++) {
+			if (st->catchment_static_always_accepted[c] != 0) SetBit(*always_accepted, c);
+		}
+	}
+	for (TileIndex tile : st->catchment_dynamic_tiles) {
 		AddAcceptedCargo(tile, acceptance, always_accepted);
 	}
 
@@ -4356,11 +4536,31 @@ const StationList *StationFinder::GetStations()
 }
 
 
-static bool CanMoveGoodsToStation(const Station *st, CargoID type)
+/**
+ * Check whether a station is excluded from receiving goods from a source, independent of the cargo type.
+ * @param st Station to check.
+ * @param exclusivity Company with exclusive rights to take cargo from the source, or INVALID_OWNER.
+ * @return True if the station must not receive goods from the source.
+ */
+bool IsStationExcludedFromGoods(const Station *st, Owner exclusivity)
 {
+	/* Is the source reserved exclusively for somebody else? */
+	if (exclusivity != INVALID_OWNER && exclusivity != st->owner) return true;
+
 	/* Is the station reserved exclusively for somebody else? */
-	if (st->owner != OWNER_NONE && st->town->exclusive_counter > 0 && st->town->exclusivity != st->owner) return false;
+	if (st->owner != OWNER_NONE && st->town->exclusive_counter > 0 && st->town->exclusivity != st->owner) return true;
 
+	return false;
+}
+
+/**
+ * Check the cargo type specific conditions for moving goods to a station.
+ * @param st Station to check, this must not be excluded by IsStationExcludedFromGoods.
+ * @param type Cargo type to move.
+ * @return True if the station can receive the goods.
+ */
+static bool CanMoveGoodsToStation(const Station *st, CargoID type)
+{
 	/* Lowest possible rating, better not to give cargo anymore. */
 	if (st->goods[type].rating == 0) return false;
 
@@ -4379,18 +4579,19 @@ static bool CanMoveGoodsToStation(const Station *st, CargoID type)
 	return true;
 }
 
-uint MoveGoodsToStation(CargoID type, uint amount, SourceType source_type, SourceID source_id, const StationList *all_stations, Owner exclusivity)
+template <typename T>
+static uint MoveGoodsToStationIntl(CargoID type, uint amount, SourceType source_type, SourceID source_id, const T &all_stations, Owner exclusivity, bool check_exclusion)
 {
 	/* Return if nothing to do. Also the rounding below fails for 0. */
-	if (all_stations->empty()) return 0;
+	if (all_stations.empty()) return 0;
 	if (amount == 0) return 0;
 
 	Station *first_station = nullptr;
 	typedef std::pair<Station *, uint> StationInfo;
 	std::vector<StationInfo> used_stations;
 
-	for (Station *st : *all_stations) {
-		if (exclusivity != INVALID_OWNER && exclusivity != st->owner) continue;
+	for (Station *st : all_stations) {
+		if (check_exclusion && IsStationExcludedFromGoods(st, exclusivity)) continue;
 		if (!CanMoveGoodsToStation(st, type)) continue;
 
 		/* Avoid allocating a vector if there is only one station to significantly
@@ -4467,6 +4668,35 @@ uint MoveGoodsToStation(CargoID type, uint amount, SourceType source_type, Sourc
 	return moved;
 }
 
+/**
+ * Move goods from a source to the stations around it.
+ * @param type Cargo type to move.
+ * @param amount Amount of cargo to move.
+ * @param source_type Type of the source.
+ * @param source_id Index of the source.
+ * @param all_stations Stations around the source.
+ * @param exclusivity Company with exclusive rights to take cargo from the source, or INVALID_OWNER.
+ * @return Amount of cargo moved to stations.
+ */
+uint MoveGoodsToStation(CargoID type, uint amount, SourceType source_type, SourceID source_id, const StationList *all_stations, Owner exclusivity)
+{
+	return MoveGoodsToStationIntl(type, amount, source_type, source_id, *all_stations, exclusivity, true);
+}
+
+/**
+ * Move goods from a source to a list of candidate stations.
+ * @param type Cargo type to move.
+ * @param amount Amount of cargo to move.
+ * @param source_type Type of the source.
+ * @param source_id Index of the source.
+ * @param candidates Stations around the source which are not excluded by IsStationExcludedFromGoods.
+ * @return Amount of cargo moved to stations.
+ */
+uint MoveGoodsToStation(CargoID type, uint amount, SourceType source_type, SourceID source_id, const std::vector<Station *> &candidates)
+{
+	return MoveGoodsToStationIntl(type, amount, source_type, source_id, candidates, INVALID_OWNER, false);
+}
+
 void UpdateStationDockingTiles(Station *st)
 {
 	st->docking_station.Clear();
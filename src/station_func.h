@@ -29,6 +29,11 @@ void ClearAllStationCachedNames();
 CargoArray GetProductionAroundTiles(TileIndex tile, int w, int h, int rad);
 CargoArray GetAcceptanceAroundTiles(TileIndex tile, int w, int h, int rad, CargoTypes *always_accepted = nullptr);
 
+CargoArray GetAcceptanceAroundStation(Station *st, CargoTypes *always_accepted, bool use_cache = true);
+void AddTileToStationAcceptanceCaches(TileIndex tile);
+void RemoveTileFromStationAcceptanceCaches(TileIndex tile);
+void InvalidateAllStationAcceptanceCaches();
+
 void UpdateStationAcceptance(Station *st, bool show_msg);
 
 const DrawTileSprites *GetStationTileLayout(StationType st, byte gfx);
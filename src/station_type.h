@@ -86,6 +86,7 @@ enum CatchmentArea {
 };
 
 static const uint MAX_LENGTH_STATION_NAME_CHARS = 128; ///< The maximum length of a station name in characters including '\0'
+static const uint MAX_STATION_SPREAD = 64; ///< Maximum value of the station spread setting, existing stations may still be this large after the setting is lowered
 
 struct StationCompare {
 	bool operator() (const Station *lhs, const Station *rhs) const;
@@ -14,6 +14,11 @@
 #include "genworld.h"
 #include "core/random_func.hpp"
 #include "landscape_type.h"
+#include "thread.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
 
 #include "safeguards.h"
 
@@ -201,6 +206,63 @@ static HeightMap _height_map = {nullptr, 0, 0, 0, 0};
 /** Walk through all items of _height_map.h */
 #define FOR_ALL_TILES_IN_HEIGHT(h) for (h = _height_map.h; h < &_height_map.h[_height_map.total_size]; h++)
 
+/** Number of height map rows in each unit of work of the parallel passes. */
+static const int TGP_ROWS_PER_BAND = 64;
+
+/** Number of height map columns in each unit of work of the parallel slope smoothing passes. */
+static const int TGP_COLUMNS_PER_CHUNK = 256;
+
+/**
+ * Run a procedure once for each of a number of bands, spread over the available hardware threads.
+ * The caller participates as well, and runs everything itself if no threads can be started.
+ * Bands are partitioned independently of the number of threads, so as long as each band only
+ * depends on data which no other band writes, the result is the same however many threads are used.
+ * @param bands Number of bands.
+ * @param proc Procedure to run, called with the index of the band to process.
+ */
+template <typename F>
+static void TgpRunParallel(int bands, F proc)
+{
+	std::atomic<int> next_band(0);
+	auto worker = [&]() {
+		for (int band = next_band++; band < bands; band = next_band++) {
+			proc(band);
+		}
+	};
+
+	int threads = std::min<int>(bands, std::thread::hardware_concurrency()) - 1;
+	std::vector<std::thread> workers;
+	for (int i = 0; i < threads; i++) {
+		std::thread thread;
+		if (!StartNewThread(&thread, "ottd:tgp", [&worker]() { worker(); })) break;
+		workers.push_back(std::move(thread));
+	}
+
+	worker();
+
+	for (std::thread &thread : workers) thread.join();
+}
+
+/**
+ * Run a procedure for each row in the given range, spread over bands of #TGP_ROWS_PER_BAND rows.
+ * @param first First row.
+ * @param last Last row (inclusive).
+ * @param stride Distance between processed rows.
+ * @param proc Procedure to run, called with the row number.
+ */
+template <typename F>
+static void TgpForEachRowParallel(int first, int last, int stride, F proc)
+{
+	if (last < first) return;
+	const int rows = (last - first) / stride + 1;
+	TgpRunParallel((rows + TGP_ROWS_PER_BAND - 1) / TGP_ROWS_PER_BAND, [&](int band) {
+		const int end = std::min(rows, (band + 1) * TGP_ROWS_PER_BAND);
+		for (int row = band * TGP_ROWS_PER_BAND; row < end; row++) {
+			proc(first + row * stride);
+		}
+	});
+}
+
 /** Maximum number of TGP noise frequencies. */
 static const int MAX_TGP_FREQUENCIES = 10;
 
@@ -398,24 +460,24 @@ static void HeightMapGenerate()
 
 		/* It is regular iteration round.
 		 * Interpolate height values at odd x, even y tiles */
-		for (int y = 0; y <= _height_map.size_y; y += 2 * step) {
+		TgpForEachRowParallel(0, _height_map.size_y, 2 * step, [&](int y) {
 			for (int x = 0; x <= _height_map.size_x - 2 * step; x += 2 * step) {
 				height_t h00 = _height_map.height(x + 0 * step, y);
 				height_t h02 = _height_map.height(x + 2 * step, y);
 				height_t h01 = (h00 + h02) / 2;
 				_height_map.height(x + 1 * step, y) = h01;
 			}
-		}
+		});
 
-		/* Interpolate height values at odd y tiles */
-		for (int y = 0; y <= _height_map.size_y - 2 * step; y += 2 * step) {
+		/* Interpolate height values at odd y tiles; the rows read are only written by the previous pass */
+		TgpForEachRowParallel(0, _height_map.size_y - 2 * step, 2 * step, [&](int y) {
 			for (int x = 0; x <= _height_map.size_x; x += step) {
 				height_t h00 = _height_map.height(x, y + 0 * step);
 				height_t h20 = _height_map.height(x, y + 2 * step);
 				height_t h10 = (h00 + h20) / 2;
 				_height_map.height(x, y + 1 * step) = h10;
 			}
-		}
+		});
 
 		/* Add noise for next higher frequency (smaller steps) */
 		for (int y = 0; y <= _height_map.size_y; y += step) {
@@ -464,81 +526,93 @@ static int *HeightMapMakeHistogram(height_t h_min, height_t h_max, int *hist_buf
 	return hist;
 }
 
-/** Applies sine wave redistribution onto height map */
-static void HeightMapSineTransform(height_t h_min, height_t h_max)
+/**
+ * Apply sine wave redistribution onto a single height map entry.
+ * @param h Height to transform.
+ * @param h_min Lowest height to transform.
+ * @param h_max Highest height.
+ */
+static inline void HeightMapSineTransformHeight(height_t *h, height_t h_min, height_t h_max)
 {
-	height_t *h;
-
-	FOR_ALL_TILES_IN_HEIGHT(h) {
-		double fheight;
-
-		if (*h < h_min) continue;
-
-		/* Transform height into 0..1 space */
-		fheight = (double)(*h - h_min) / (double)(h_max - h_min);
-		/* Apply sine transform depending on landscape type */
-		switch (_settings_game.game_creation.landscape) {
-			case LT_TOYLAND:
-			case LT_TEMPERATE:
-				/* Move and scale 0..1 into -1..+1 */
-				fheight = 2 * fheight - 1;
-				/* Sine transform */
-				fheight = sin(fheight * M_PI_2);
-				/* Transform it back from -1..1 into 0..1 space */
-				fheight = 0.5 * (fheight + 1);
-				break;
-
-			case LT_ARCTIC:
-				{
-					/* Arctic terrain needs special height distribution.
-					 * Redistribute heights to have more tiles at highest (75%..100%) range */
-					double sine_upper_limit = 0.75;
-					double linear_compression = 2;
-					if (fheight >= sine_upper_limit) {
-						/* Over the limit we do linear compression up */
-						fheight = 1.0 - (1.0 - fheight) / linear_compression;
-					} else {
-						double m = 1.0 - (1.0 - sine_upper_limit) / linear_compression;
-						/* Get 0..sine_upper_limit into -1..1 */
-						fheight = 2.0 * fheight / sine_upper_limit - 1.0;
-						/* Sine wave transform */
-						fheight = sin(fheight * M_PI_2);
-						/* Get -1..1 back to 0..(1 - (1 - sine_upper_limit) / linear_compression) == 0.0..m */
-						fheight = 0.5 * (fheight + 1.0) * m;
-					}
+	double fheight;
+
+	if (*h < h_min) return;
+
+	/* Transform height into 0..1 space */
+	fheight = (double)(*h - h_min) / (double)(h_max - h_min);
+	/* Apply sine transform depending on landscape type */
+	switch (_settings_game.game_creation.landscape) {
+		case LT_TOYLAND:
+		case LT_TEMPERATE:
+			/* Move and scale 0..1 into -1..+1 */
+			fheight = 2 * fheight - 1;
+			/* Sine transform */
+			fheight = sin(fheight * M_PI_2);
+			/* Transform it back from -1..1 into 0..1 space */
+			fheight = 0.5 * (fheight + 1);
+			break;
+
+		case LT_ARCTIC:
+			{
+				/* Arctic terrain needs special height distribution.
+				 * Redistribute heights to have more tiles at highest (75%..100%) range */
+				double sine_upper_limit = 0.75;
+				double linear_compression = 2;
+				if (fheight >= sine_upper_limit) {
+					/* Over the limit we do linear compression up */
+					fheight = 1.0 - (1.0 - fheight) / linear_compression;
+				} else {
+					double m = 1.0 - (1.0 - sine_upper_limit) / linear_compression;
+					/* Get 0..sine_upper_limit into -1..1 */
+					fheight = 2.0 * fheight / sine_upper_limit - 1.0;
+					/* Sine wave transform */
+					fheight = sin(fheight * M_PI_2);
+					/* Get -1..1 back to 0..(1 - (1 - sine_upper_limit) / linear_compression) == 0.0..m */
+					fheight = 0.5 * (fheight + 1.0) * m;
 				}
-				break;
-
-			case LT_TROPIC:
-				{
-					/* Desert terrain needs special height distribution.
-					 * Half of tiles should be at lowest (0..25%) heights */
-					double sine_lower_limit = 0.5;
-					double linear_compression = 2;
-					if (fheight <= sine_lower_limit) {
-						/* Under the limit we do linear compression down */
-						fheight = fheight / linear_compression;
-					} else {
-						double m = sine_lower_limit / linear_compression;
-						/* Get sine_lower_limit..1 into -1..1 */
-						fheight = 2.0 * ((fheight - sine_lower_limit) / (1.0 - sine_lower_limit)) - 1.0;
-						/* Sine wave transform */
-						fheight = sin(fheight * M_PI_2);
-						/* Get -1..1 back to (sine_lower_limit / linear_compression)..1.0 */
-						fheight = 0.5 * ((1.0 - m) * fheight + (1.0 + m));
-					}
+			}
+			break;
+
+		case LT_TROPIC:
+			{
+				/* Desert terrain needs special height distribution.
+				 * Half of tiles should be at lowest (0..25%) heights */
+				double sine_lower_limit = 0.5;
+				double linear_compression = 2;
+				if (fheight <= sine_lower_limit) {
+					/* Under the limit we do linear compression down */
+					fheight = fheight / linear_compression;
+				} else {
+					double m = sine_lower_limit / linear_compression;
+					/* Get sine_lower_limit..1 into -1..1 */
+					fheight = 2.0 * ((fheight - sine_lower_limit) / (1.0 - sine_lower_limit)) - 1.0;
+					/* Sine wave transform */
+					fheight = sin(fheight * M_PI_2);
+					/* Get -1..1 back to (sine_lower_limit / linear_compression)..1.0 */
+					fheight = 0.5 * ((1.0 - m) * fheight + (1.0 + m));
 				}
-				break;
+			}
+			break;
 
-			default:
-				NOT_REACHED();
-				break;
-		}
-		/* Transform it back into h_min..h_max space */
-		*h = (height_t)(fheight * (h_max - h_min) + h_min);
-		if (*h < 0) *h = I2H(0);
-		if (*h >= h_max) *h = h_max - 1;
+		default:
+			NOT_REACHED();
+			break;
 	}
+	/* Transform it back into h_min..h_max space */
+	*h = (height_t)(fheight * (h_max - h_min) + h_min);
+	if (*h < 0) *h = I2H(0);
+	if (*h >= h_max) *h = h_max - 1;
+}
+
+/** Applies sine wave redistribution onto height map */
+static void HeightMapSineTransform(height_t h_min, height_t h_max)
+{
+	TgpForEachRowParallel(0, _height_map.size_y, 1, [&](int y) {
+		height_t *h = &_height_map.height(0, y);
+		for (height_t *end = h + _height_map.dim_x; h < end; h++) {
+			HeightMapSineTransformHeight(h, h_min, h_max);
+		}
+	});
 }
 
 /**
@@ -586,9 +660,6 @@ static void HeightMapCurves(uint level)
 		{ lengthof(curve_map_4), curve_map_4 },
 	};
 
-	height_t ht[lengthof(curve_maps)];
-	MemSetT(ht, 0, lengthof(ht));
-
 	/* Set up a grid to choose curve maps based on location; attempt to get a somewhat square grid */
 	float factor = sqrt((float)_height_map.size_x / (float)_height_map.size_y);
 	uint sx = Clamp((int)(((1 << level) * factor) + 0.5), 1, 128);
@@ -599,9 +670,15 @@ static void HeightMapCurves(uint level)
 		c[i] = Random() % lengthof(curve_maps);
 	}
 
-	/* Apply curves */
+	/** X grid positions and bi-linear ratio of a column, these are the same for every row. */
+	struct grid_column_t {
+		uint x1;   ///< First grid column.
+		uint x2;   ///< Second grid column.
+		float xr;  ///< Ratio of the second grid column.
+		float xri; ///< Ratio of the first grid column.
+	};
+	std::vector<grid_column_t> columns(_height_map.size_x);
 	for (int x = 0; x < _height_map.size_x; x++) {
-
 		/* Get our X grid positions and bi-linear ratio */
 		float fx = (float)(sx * x) / _height_map.size_x + 1.0f;
 		uint x1 = (uint)fx;
@@ -617,27 +694,36 @@ static void HeightMapCurves(uint level)
 			if (x2 >= sx) x2--;
 		}
 
-		for (int y = 0; y < _height_map.size_y; y++) {
-
-			/* Get our Y grid position and bi-linear ratio */
-			float fy = (float)(sy * y) / _height_map.size_y + 1.0f;
-			uint y1 = (uint)fy;
-			uint y2 = y1;
-			float yr = 2.0f * (fy - y1) - 1.0f;
-			yr = sin(yr * M_PI_2);
-			yr = sin(yr * M_PI_2);
-			yr = 0.5f * (yr + 1.0f);
-			float yri = 1.0f - yr;
-
-			if (y1 > 0) {
-				y1--;
-				if (y2 >= sy) y2--;
-			}
+		columns[x] = { x1, x2, xr, xri };
+	}
 
-			uint corner_a = c[x1 + sx * y1];
-			uint corner_b = c[x1 + sx * y2];
-			uint corner_c = c[x2 + sx * y1];
-			uint corner_d = c[x2 + sx * y2];
+	/* Apply curves */
+	TgpForEachRowParallel(0, _height_map.size_y - 1, 1, [&](int y) {
+		height_t ht[lengthof(curve_maps)];
+		MemSetT(ht, 0, lengthof(ht));
+
+		/* Get our Y grid position and bi-linear ratio */
+		float fy = (float)(sy * y) / _height_map.size_y + 1.0f;
+		uint y1 = (uint)fy;
+		uint y2 = y1;
+		float yr = 2.0f * (fy - y1) - 1.0f;
+		yr = sin(yr * M_PI_2);
+		yr = sin(yr * M_PI_2);
+		yr = 0.5f * (yr + 1.0f);
+		float yri = 1.0f - yr;
+
+		if (y1 > 0) {
+			y1--;
+			if (y2 >= sy) y2--;
+		}
+
+		for (int x = 0; x < _height_map.size_x; x++) {
+			const grid_column_t &col = columns[x];
+
+			uint corner_a = c[col.x1 + sx * y1];
+			uint corner_b = c[col.x1 + sx * y2];
+			uint corner_c = c[col.x2 + sx * y1];
+			uint corner_d = c[col.x2 + sx * y2];
 
 			/* Bitmask of which curve maps are chosen, so that we do not bother
 			 * calculating a curve which won't be used. */
@@ -679,12 +765,12 @@ static void HeightMapCurves(uint level)
 			}
 
 			/* Apply interpolation of curve map results. */
-			*h = (height_t)((ht[corner_a] * yri + ht[corner_b] * yr) * xri + (ht[corner_c] * yri + ht[corner_d] * yr) * xr);
+			*h = (height_t)((ht[corner_a] * yri + ht[corner_b] * yr) * col.xri + (ht[corner_c] * yri + ht[corner_d] * yr) * col.xr);
 
 			/* Readd sea level */
 			*h += I2H(1);
 		}
-	}
+	});
 }
 
 /** Adjusts heights in height map to contain required amount of water tiles */
@@ -858,6 +944,60 @@ static void HeightMapSmoothCoasts(uint8 water_borders)
 	}
 }
 
+/**
+ * One pass of HeightMapSmoothSlopes, limiting each height to dh_max above the lower of its already
+ * processed neighbours in the X and Y direction.
+ * The pass runs forwards from the north corner or, if \a reverse, backwards from the south corner.
+ *
+ * As every height depends on the result of the previous height in the same row and on the previous row,
+ * the map is split into bands of rows which are processed as a wavefront: each band processes chunks of
+ * columns in turn, waiting until the preceding band has finished the same chunk. This evaluates every height
+ * with exactly the same inputs as a plain row by row loop, whatever the number of threads.
+ * @tparam reverse Whether to run the pass backwards.
+ * @param dh_max Maximum height difference to a processed neighbour.
+ */
+template <bool reverse>
+static void HeightMapSmoothSlopesPass(height_t dh_max)
+{
+	const int size_x = _height_map.size_x;
+	const int size_y = _height_map.size_y;
+	const int bands = (size_y + TGP_ROWS_PER_BAND) / TGP_ROWS_PER_BAND;
+	const int chunks = (size_x + TGP_COLUMNS_PER_CHUNK) / TGP_COLUMNS_PER_CHUNK;
+
+	/* Number of chunks of columns fully processed by each band. */
+	std::vector<std::atomic<int>> progress(bands);
+	for (std::atomic<int> &p : progress) p.store(0);
+
+	TgpRunParallel(bands, [&](int band) {
+		const int row_first = band * TGP_ROWS_PER_BAND;
+		const int row_end = std::min(size_y + 1, row_first + TGP_ROWS_PER_BAND);
+		for (int chunk = 0; chunk < chunks; chunk++) {
+			/* Bands are handed out in order, so the band we wait for is always being processed by some thread. */
+			if (band > 0) {
+				while (progress[band - 1].load() <= chunk) std::this_thread::yield();
+			}
+
+			const int column_first = chunk * TGP_COLUMNS_PER_CHUNK;
+			const int column_end = std::min(size_x + 1, column_first + TGP_COLUMNS_PER_CHUNK);
+			for (int row = row_first; row < row_end; row++) {
+				const int y = reverse ? size_y - row : row;
+				for (int column = column_first; column < column_end; column++) {
+					const int x = reverse ? size_x - column : column;
+					height_t h_max;
+					if (reverse) {
+						h_max = std::min(_height_map.height(x < size_x ? x + 1 : x, y), _height_map.height(x, y < size_y ? y + 1 : y)) + dh_max;
+					} else {
+						h_max = std::min(_height_map.height(x > 0 ? x - 1 : x, y), _height_map.height(x, y > 0 ? y - 1 : y)) + dh_max;
+					}
+					if (_height_map.height(x, y) > h_max) _height_map.height(x, y) = h_max;
+				}
+			}
+
+			progress[band].store(chunk + 1);
+		}
+	});
+}
+
 /**
  * This routine provides the essential cleanup necessary before OTTD can
  * display the terrain. When generated, the terrain heights can jump more than
@@ -867,18 +1007,8 @@ static void HeightMapSmoothCoasts(uint8 water_borders)
  */
 static void HeightMapSmoothSlopes(height_t dh_max)
 {
-	for (int y = 0; y <= (int)_height_map.size_y; y++) {
-		for (int x = 0; x <= (int)_height_map.size_x; x++) {
-			height_t h_max = std::min(_height_map.height(x > 0 ? x - 1 : x, y), _height_map.height(x, y > 0 ? y - 1 : y)) + dh_max;
-			if (_height_map.height(x, y) > h_max) _height_map.height(x, y) = h_max;
-		}
-	}
-	for (int y = _height_map.size_y; y >= 0; y--) {
-		for (int x = _height_map.size_x; x >= 0; x--) {
-			height_t h_max = std::min(_height_map.height(x < _height_map.size_x ? x + 1 : x, y), _height_map.height(x, y < _height_map.size_y ? y + 1 : y)) + dh_max;
-			if (_height_map.height(x, y) > h_max) _height_map.height(x, y) = h_max;
-		}
-	}
+	HeightMapSmoothSlopesPass<false>(dh_max);
+	HeightMapSmoothSlopesPass<true>(dh_max);
 }
 
 /**
@@ -1026,12 +1156,12 @@ void GenerateTerrainPerlin()
 
 	int max_height = H2I(TGPGetMaxHeight());
 
-	/* Transfer height map into OTTD map */
-	for (int y = 0; y < _height_map.size_y; y++) {
+	/* Transfer height map into OTTD map; every tile is written independently of all others */
+	TgpForEachRowParallel(0, _height_map.size_y - 1, 1, [&](int y) {
 		for (int x = 0; x < _height_map.size_x; x++) {
 			TgenSetTileHeight(TileXY(x, y), Clamp(H2I(_height_map.height(x, y)), 0, max_height));
 		}
-	}
+	});
 
 	IncreaseGeneratingWorldProgress(GWP_LANDSCAPE);
 
@@ -736,31 +736,8 @@ static bool IsVehicleAtFirstWaitingLocation(const Vehicle *v)
 
 static DateTicksScaled GetScheduledDispatchTime(Vehicle *v, int wait_offset)
 {
-	DateTicksScaled first_slot          = -1;
-	const DateTicksScaled begin_time    = v->orders.list->GetScheduledDispatchStartTick();
-	const int32 last_dispatched_offset  = v->orders.list->GetScheduledDispatchLastDispatch();
-	const uint32 dispatch_duration      = v->orders.list->GetScheduledDispatchDuration();
-	const int32 max_delay               = v->orders.list->GetScheduledDispatchDelay();
-
-	/* Find next available slots */
-	for (auto current_offset : v->orders.list->GetScheduledDispatch()) {
-		if (current_offset >= dispatch_duration) continue;
-		if (int32(current_offset) <= last_dispatched_offset) {
-			current_offset += dispatch_duration * ((last_dispatched_offset + dispatch_duration - current_offset) / dispatch_duration);
-		}
-
-		DateTicksScaled current_departure = begin_time + current_offset;
-		DateTicksScaled minimum = _scaled_date_ticks + wait_offset - max_delay;
-		if (current_departure < minimum) {
-			current_departure += dispatch_duration * ((minimum + dispatch_duration - current_departure - 1) / dispatch_duration);
-		}
-
-		if (first_slot == -1 || first_slot > current_departure) {
-			first_slot = current_departure;
-		}
-	}
-
-	return first_slot;
+	const DateTicksScaled minimum = _scaled_date_ticks + wait_offset - v->orders.list->GetScheduledDispatchDelay();
+	return v->orders.list->GetScheduledDispatchNextSlot(minimum - 1);
 }
 
 /**
@@ -94,8 +94,9 @@ struct Town : TownPool::PoolItem<&_town_pool> {
 
 	uint16 time_until_rebuild;       ///< time until we rebuild a house
 
-	uint16 grow_counter;             ///< counter to count when to grow, value is smaller than or equal to growth_rate
+	uint16 grow_counter;             ///< counter to count when to grow, value is smaller than or equal to growth_rate. Stale while the town is in the growth schedule, use GetGrowCounter()
 	uint16 growth_rate;              ///< town growth rate
+	uint64 grow_due_tick;            ///< NOSAVE: town growth schedule tick at which the town next grows, 0 if the town is not in the growth schedule
 
 	byte fund_buildings_months;      ///< fund buildings program in action?
 	byte road_build_months;          ///< fund road reconstruction in action?
@@ -105,6 +106,10 @@ struct Town : TownPool::PoolItem<&_town_pool> {
 
 	bool show_zone;                  ///< NOSAVE: mark town to show the local authority zone in the viewports
 
+	std::vector<TileIndex> growth_frontier; ///< Sorted road tiles at the edge of the town from which it can grow, used when economy.town_growth_frontier is set
+	std::vector<uint8> growth_frontier_failures; ///< Number of consecutive failed growth attempts from each #growth_frontier tile
+	bool growth_frontier_built;      ///< #growth_frontier has been built and is kept up to date, even if it is empty
+
 	std::list<PersistentStorage *> psa_list;
 
 	/**
@@ -120,6 +125,8 @@ struct Town : TownPool::PoolItem<&_town_pool> {
 
 	void UpdateLabel();
 
+	uint16 GetGrowCounter() const;
+
 	/**
 	 * Returns the correct town label, based on rating.
 	 */
@@ -185,6 +192,9 @@ void ShowTownViewWindow(TownID town);
 void ExpandTown(Town *t);
 
 void RebuildTownKdtree();
+void RebuildTownGrowthSchedule();
+void UpdateTownGrowthFrontierAroundTile(TileIndex tile);
+void ClearAllTownGrowthFrontiers();
 
 
 /**
@@ -229,6 +239,7 @@ void ResetHouses();
 
 void ClearTownHouse(Town *t, TileIndex tile);
 void UpdateTownMaxPass(Town *t);
+void CalculateTownZoneRadius(const Town *t, uint32 num_houses, uint32 (&squared_town_zone_radius)[HZB_END]);
 void UpdateTownRadius(Town *t);
 CommandCost CheckIfAuthorityAllowsNewStation(TileIndex tile, DoCommandFlag flags);
 Town *ClosestTownFromTile(TileIndex tile, uint threshold);
@@ -21,6 +21,7 @@
 #include "command_func.h"
 #include "industry.h"
 #include "station_base.h"
+#include "station_func.h"
 #include "station_kdtree.h"
 #include "company_base.h"
 #include "news_func.h"
@@ -53,6 +54,7 @@
 #include "zoom_func.h"
 #include "zoning.h"
 #include "scope.h"
+#include "3rdparty/cpp-btree/btree_set.h"
 
 #include "table/strings.h"
 #include "table/town_land.h"
@@ -104,8 +106,12 @@ static bool TestTownOwnsBridge(TileIndex tile, const Town *t)
 	return town_owned;
 }
 
+static void UnscheduleTownGrowth(Town *t);
+
 Town::~Town()
 {
+	UnscheduleTownGrowth(this);
+
 	if (CleaningPool()) return;
 
 	/* Delete town authority window
@@ -949,28 +955,93 @@ static void ChangeTileOwner_Town(TileIndex tile, Owner old_owner, Owner new_owne
 
 static bool GrowTown(Town *t);
 
+/**
+ * Growing towns, ordered by the town tick at which their grow counter runs out, then by town index.
+ * This is the same order in which towns would grow when decrementing the grow counter of every town each tick.
+ */
+static btree::btree_set<std::pair<uint64, TownID>> _town_growth_schedule;
+static uint64 _town_growth_ticks = 0; ///< NOSAVE: Number of town ticks run, only used relative to Town::grow_due_tick.
+
+/**
+ * Get the current value of the grow counter of the town.
+ * @return The grow counter, whether or not the town is in the growth schedule.
+ */
+uint16 Town::GetGrowCounter() const
+{
+	if (this->grow_due_tick == 0) return this->grow_counter;
+	return (uint16)(this->grow_due_tick - 1 - _town_growth_ticks);
+}
+
+/**
+ * Remove a town from the growth schedule, if it is in it.
+ * The current grow counter is written back to Town::grow_counter.
+ * @param t The town.
+ */
+static void UnscheduleTownGrowth(Town *t)
+{
+	if (t->grow_due_tick == 0) return;
+
+	t->grow_counter = t->GetGrowCounter();
+	_town_growth_schedule.erase(std::make_pair(t->grow_due_tick, t->index));
+	t->grow_due_tick = 0;
+}
+
+/**
+ * (Re)insert a town into the growth schedule, based on its current grow counter and growing flag.
+ * @param t The town.
+ */
+static void ScheduleTownGrowth(Town *t)
+{
+	UnscheduleTownGrowth(t);
+	if (!HasBit(t->flags, TOWN_IS_GROWING)) return;
+
+	t->grow_due_tick = _town_growth_ticks + 1 + t->grow_counter;
+	_town_growth_schedule.insert(std::make_pair(t->grow_due_tick, t->index));
+}
+
+/** Rebuild the town growth schedule from the grow counters of all towns, e.g. after loading a game. */
+void RebuildTownGrowthSchedule()
+{
+	_town_growth_schedule.clear();
+	for (Town *t : Town::Iterate()) {
+		t->grow_due_tick = 0;
+		ScheduleTownGrowth(t);
+	}
+}
+
+/**
+ * Grow a town whose grow counter has run out this tick.
+ * @param t The town, which must be due to grow at the current town tick.
+ */
 static void TownTickHandler(Town *t)
 {
-	if (HasBit(t->flags, TOWN_IS_GROWING)) {
-		int i = (int)t->grow_counter - 1;
-		if (i < 0) {
-			if (GrowTown(t)) {
-				i = t->growth_rate;
-			} else {
-				/* If growth failed wait a bit before retrying */
-				i = std::min<uint16>(t->growth_rate, TOWN_GROWTH_TICKS - 1);
-			}
-		}
-		t->grow_counter = i;
+	assert(t->grow_due_tick == _town_growth_ticks);
+	_town_growth_schedule.erase(std::make_pair(t->grow_due_tick, t->index));
+	t->grow_due_tick = 0;
+	t->grow_counter = 0;
+
+	uint16 i;
+	if (GrowTown(t)) {
+		i = t->growth_rate;
+	} else {
+		/* If growth failed wait a bit before retrying */
+		i = std::min<uint16>(t->growth_rate, TOWN_GROWTH_TICKS - 1);
 	}
+	UnscheduleTownGrowth(t);
+	t->grow_counter = i;
+	ScheduleTownGrowth(t);
 }
 
 void OnTick_Town()
 {
 	if (_game_mode == GM_EDITOR) return;
 
-	for (Town *t : Town::Iterate()) {
-		TownTickHandler(t);
+	_town_growth_ticks++;
+
+	/* Only towns whose grow counter runs out this tick need to be visited.
+	 * Rescheduled towns are always due at a later tick, so this terminates. */
+	while (!_town_growth_schedule.empty() && _town_growth_schedule.begin()->first == _town_growth_ticks) {
+		TownTickHandler(Town::Get(_town_growth_schedule.begin()->second));
 	}
 }
 
@@ -1783,13 +1854,141 @@ static bool CanFollowRoad(TileIndex tile, DiagDirection dir)
 	}
 }
 
+/** Number of road steps to search when growing from a growth frontier tile. */
+static const int TOWN_GROWTH_FRONTIER_SEARCH_STEPS = 10;
+
+/** Number of consecutive failed growth attempts after which a tile is dropped from the growth frontier, until a change next to it adds it back. */
+static const uint8 TOWN_GROWTH_FRONTIER_MAX_FAILURES = 8;
+
+/**
+ * Check whether a tile is on the growth frontier of a town.
+ * That is a road tile of the town, next to land on which the town could still build houses or roads.
+ * @param t The town.
+ * @param tile The tile to check.
+ * @return true if the tile is a growth frontier tile of the town.
+ */
+static bool IsTownGrowthFrontierTile(const Town *t, TileIndex tile)
+{
+	if (!IsValidTile(tile) || !IsTileType(tile, MP_ROAD) || IsRoadDepot(tile)) return false;
+	if (GetTownIndex(tile) != t->index || GetTownRoadBits(tile) == ROAD_NONE) return false;
+
+	for (DiagDirection dir = DIAGDIR_BEGIN; dir < DIAGDIR_END; dir++) {
+		TileIndex neighbour = TileAddByDiagDir(tile, dir);
+		if (!IsValidTile(neighbour)) continue;
+		if (IsTileType(neighbour, MP_CLEAR) || IsTileType(neighbour, MP_TREES)) return true;
+	}
+	return false;
+}
+
+/**
+ * Add a tile to the growth frontier of a town, if it is a frontier tile and not already in it.
+ * @param t The town.
+ * @param tile The tile.
+ */
+static void AddTownGrowthFrontierTile(Town *t, TileIndex tile)
+{
+	if (!IsTownGrowthFrontierTile(t, tile)) return;
+
+	auto iter = std::lower_bound(t->growth_frontier.begin(), t->growth_frontier.end(), tile);
+	if (iter == t->growth_frontier.end() || *iter != tile) {
+		t->growth_frontier_failures.insert(t->growth_frontier_failures.begin() + (iter - t->growth_frontier.begin()), 0);
+		t->growth_frontier.insert(iter, tile);
+	}
+}
+
+/**
+ * Remove a tile from the growth frontier of a town.
+ * @param t The town.
+ * @param index Index of the tile in the growth frontier.
+ */
+static void RemoveTownGrowthFrontierTile(Town *t, size_t index)
+{
+	t->growth_frontier.erase(t->growth_frontier.begin() + index);
+	t->growth_frontier_failures.erase(t->growth_frontier_failures.begin() + index);
+}
+
+/**
+ * Record the result of trying to grow a town from one of its growth frontier tiles.
+ * Tiles from which the town repeatedly fails to grow are removed from the frontier.
+ * @param t The town.
+ * @param tile The frontier tile.
+ * @param success Whether the town grew.
+ */
+static void RecordTownGrowthFrontierResult(Town *t, TileIndex tile, bool success)
+{
+	/* Growing may have changed the frontier, so look the tile up again. */
+	auto iter = std::lower_bound(t->growth_frontier.begin(), t->growth_frontier.end(), tile);
+	if (iter == t->growth_frontier.end() || *iter != tile) return;
+
+	size_t index = iter - t->growth_frontier.begin();
+	if (success) {
+		t->growth_frontier_failures[index] = 0;
+	} else if (++t->growth_frontier_failures[index] >= TOWN_GROWTH_FRONTIER_MAX_FAILURES) {
+		RemoveTownGrowthFrontierTile(t, index);
+	}
+}
+
+/**
+ * Rebuild the growth frontier of a town by scanning the area around the town centre.
+ * @param t The town.
+ */
+static void RebuildTownGrowthFrontier(Town *t)
+{
+	t->growth_frontier.clear();
+	t->growth_frontier_built = true;
+
+	uint radius = IntSqrt(t->cache.squared_town_zone_radius[HZB_TOWN_EDGE]) + 2;
+	OrthogonalTileArea area(t->xy, 1, 1);
+	area.Expand(radius);
+	TILE_AREA_LOOP(tile, area) {
+		/* Tiles are visited in increasing order, so the frontier stays sorted. */
+		if (IsTownGrowthFrontierTile(t, tile)) t->growth_frontier.push_back(tile);
+	}
+	t->growth_frontier_failures.assign(t->growth_frontier.size(), 0);
+}
+
+/**
+ * Update the growth frontiers of the towns owning a tile and its neighbours, after the tile changed.
+ * This must be called when roads are built or removed, and when a tile is cleared.
+ * Tiles which are no longer frontier tiles are removed when they are next picked.
+ * @param tile The tile which changed.
+ */
+void UpdateTownGrowthFrontierAroundTile(TileIndex tile)
+{
+	if (!_settings_game.economy.town_growth_frontier) return;
+
+	auto update_tile = [](TileIndex t) {
+		if (!IsValidTile(t) || !IsTileType(t, MP_ROAD) || IsRoadDepot(t)) return;
+		Town *town = Town::GetIfValid(GetTownIndex(t));
+		if (town != nullptr && town->growth_frontier_built) AddTownGrowthFrontierTile(town, t);
+	};
+
+	update_tile(tile);
+	for (DiagDirection dir = DIAGDIR_BEGIN; dir < DIAGDIR_END; dir++) {
+		update_tile(TileAddByDiagDir(tile, dir));
+	}
+}
+
+/** Clear the growth frontiers of all towns, they are rebuilt when next needed. */
+void ClearAllTownGrowthFrontiers()
+{
+	for (Town *t : Town::Iterate()) {
+		t->growth_frontier.clear();
+		t->growth_frontier.shrink_to_fit();
+		t->growth_frontier_failures.clear();
+		t->growth_frontier_failures.shrink_to_fit();
+		t->growth_frontier_built = false;
+	}
+}
+
 /**
  * Returns "growth" if a house was built, or no if the build failed.
  * @param t town to inquiry
  * @param tile to inquiry
+ * @param from_frontier whether the tile was picked from the growth frontier of the town, which limits the search
  * @return true if town expansion was possible
  */
-static bool GrowTownAtRoad(Town *t, TileIndex tile)
+static bool GrowTownAtRoad(Town *t, TileIndex tile, bool from_frontier = false)
 {
 	/* Special case.
 	 * @see GrowTownInTile Check the else if
@@ -1801,19 +2000,24 @@ static bool GrowTownAtRoad(Town *t, TileIndex tile)
 	/* Number of times to search.
 	 * Better roads, 2X2 and 3X3 grid grow quite fast so we give
 	 * them a little handicap. */
-	switch (t->layout) {
-		case TL_BETTER_ROADS:
-			_grow_town_result = 10 + t->cache.num_houses * 2 / 9;
-			break;
+	if (from_frontier) {
+		/* The frontier tile is already at the edge of the town, no need to walk far. */
+		_grow_town_result = TOWN_GROWTH_FRONTIER_SEARCH_STEPS;
+	} else {
+		switch (t->layout) {
+			case TL_BETTER_ROADS:
+				_grow_town_result = 10 + t->cache.num_houses * 2 / 9;
+				break;
 
-		case TL_3X3_GRID:
-		case TL_2X2_GRID:
-			_grow_town_result = 10 + t->cache.num_houses * 1 / 9;
-			break;
+			case TL_3X3_GRID:
+			case TL_2X2_GRID:
+				_grow_town_result = 10 + t->cache.num_houses * 1 / 9;
+				break;
 
-		default:
-			_grow_town_result = 10 + t->cache.num_houses * 4 / 9;
-			break;
+			default:
+				_grow_town_result = 10 + t->cache.num_houses * 4 / 9;
+				break;
+		}
 	}
 
 	do {
@@ -1918,6 +2122,28 @@ static bool GrowTown(Town *t)
 	/* Current "company" is a town */
 	Backup<CompanyID> cur_company(_current_company, OWNER_TOWN, FILE_LINE);
 
+	if (_settings_game.economy.town_growth_frontier && !_generating_world) {
+		/* Start from a random road tile at the edge of the town, instead of walking there from the centre.
+		 * An empty frontier is kept until a change adds a tile to it, instead of being rebuilt each time. */
+		if (!t->growth_frontier_built) RebuildTownGrowthFrontier(t);
+		for (uint attempt = 0; attempt < 4 && !t->growth_frontier.empty(); attempt++) {
+			uint index = RandomRange((uint32)t->growth_frontier.size());
+			TileIndex frontier_tile = t->growth_frontier[index];
+			if (!IsTownGrowthFrontierTile(t, frontier_tile)) {
+				RemoveTownGrowthFrontierTile(t, index);
+				continue;
+			}
+			bool success = GrowTownAtRoad(t, frontier_tile, true);
+			RecordTownGrowthFrontierResult(t, frontier_tile, success);
+			if (success) {
+				cur_company.Restore();
+				return true;
+			}
+			/* Fall back to the road walk from the centre. */
+			break;
+		}
+	}
+
 	TileIndex tile = t->xy; // The tile we are working with ATM
 
 	/* Find a road that we can base the construction on. */
@@ -1953,7 +2179,13 @@ static bool GrowTown(Town *t)
 	return false;
 }
 
-void UpdateTownRadius(Town *t)
+/**
+ * Calculate the town zone radii of a town.
+ * @param t The town.
+ * @param num_houses Number of houses of the town.
+ * @param[out] squared_town_zone_radius Squared radius of each town zone.
+ */
+void CalculateTownZoneRadius(const Town *t, uint32 num_houses, uint32 (&squared_town_zone_radius)[HZB_END])
 {
 	static const uint32 _town_squared_town_zone_radius_data[23][5] = {
 		{  4,  0,  0,  0,  0}, // 0
@@ -1982,34 +2214,39 @@ void UpdateTownRadius(Town *t)
 	};
 
 	if (_settings_game.economy.town_zone_calc_mode && t->larger_town) {
-		int mass = t->cache.num_houses / 8;
-		t->cache.squared_town_zone_radius[0] = mass * _settings_game.economy.city_zone_0_mult;
-		t->cache.squared_town_zone_radius[1] = mass * _settings_game.economy.city_zone_1_mult;
-		t->cache.squared_town_zone_radius[2] = mass * _settings_game.economy.city_zone_2_mult;
-		t->cache.squared_town_zone_radius[3] = mass * _settings_game.economy.city_zone_3_mult;
-		t->cache.squared_town_zone_radius[4] = mass * _settings_game.economy.city_zone_4_mult;
+		int mass = num_houses / 8;
+		squared_town_zone_radius[0] = mass * _settings_game.economy.city_zone_0_mult;
+		squared_town_zone_radius[1] = mass * _settings_game.economy.city_zone_1_mult;
+		squared_town_zone_radius[2] = mass * _settings_game.economy.city_zone_2_mult;
+		squared_town_zone_radius[3] = mass * _settings_game.economy.city_zone_3_mult;
+		squared_town_zone_radius[4] = mass * _settings_game.economy.city_zone_4_mult;
 	} else if (_settings_game.economy.town_zone_calc_mode) {
-		int mass = t->cache.num_houses / 8;
-		t->cache.squared_town_zone_radius[0] = mass * _settings_game.economy.town_zone_0_mult;
-		t->cache.squared_town_zone_radius[1] = mass * _settings_game.economy.town_zone_1_mult;
-		t->cache.squared_town_zone_radius[2] = mass * _settings_game.economy.town_zone_2_mult;
-		t->cache.squared_town_zone_radius[3] = mass * _settings_game.economy.town_zone_3_mult;
-		t->cache.squared_town_zone_radius[4] = mass * _settings_game.economy.town_zone_4_mult;
-	} else if (t->cache.num_houses < 92) {
-		memcpy(t->cache.squared_town_zone_radius, _town_squared_town_zone_radius_data[t->cache.num_houses / 4], sizeof(t->cache.squared_town_zone_radius));
+		int mass = num_houses / 8;
+		squared_town_zone_radius[0] = mass * _settings_game.economy.town_zone_0_mult;
+		squared_town_zone_radius[1] = mass * _settings_game.economy.town_zone_1_mult;
+		squared_town_zone_radius[2] = mass * _settings_game.economy.town_zone_2_mult;
+		squared_town_zone_radius[3] = mass * _settings_game.economy.town_zone_3_mult;
+		squared_town_zone_radius[4] = mass * _settings_game.economy.town_zone_4_mult;
+	} else if (num_houses < 92) {
+		memcpy(squared_town_zone_radius, _town_squared_town_zone_radius_data[num_houses / 4], sizeof(squared_town_zone_radius));
 	} else {
-		int mass = t->cache.num_houses / 8;
+		int mass = num_houses / 8;
 		/* Actually we are proportional to sqrt() but that's right because we are covering an area.
 		 * The offsets are to make sure the radii do not decrease in size when going from the table
 		 * to the calculated value.*/
-		t->cache.squared_town_zone_radius[0] = mass * 15 - 40;
-		t->cache.squared_town_zone_radius[1] = mass * 9 - 15;
-		t->cache.squared_town_zone_radius[2] = 0;
-		t->cache.squared_town_zone_radius[3] = mass * 5 - 5;
-		t->cache.squared_town_zone_radius[4] = mass * 3 + 5;
+		squared_town_zone_radius[0] = mass * 15 - 40;
+		squared_town_zone_radius[1] = mass * 9 - 15;
+		squared_town_zone_radius[2] = 0;
+		squared_town_zone_radius[3] = mass * 5 - 5;
+		squared_town_zone_radius[4] = mass * 3 + 5;
 	}
 }
 
+void UpdateTownRadius(Town *t)
+{
+	CalculateTownZoneRadius(t, t->cache.num_houses, t->cache.squared_town_zone_radius);
+}
+
 void UpdateTownMaxPass(Town *t)
 {
 	t->supplied[CT_PASSENGERS].old_max = t->cache.population >> 3;
@@ -2530,6 +2767,7 @@ static inline void ClearMakeHouseTile(TileIndex tile, Town *t, byte counter, byt
 	IncreaseBuildingCount(t, type);
 	MakeHouseTile(tile, t->index, counter, stage, type, random_bits);
 	if (HouseSpec::Get(type)->building_flags & BUILDING_IS_ANIMATED) AddAnimatedTile(tile);
+	AddTileToStationAcceptanceCaches(tile);
 
 	MarkTileDirtyByTile(tile);
 }
@@ -2971,6 +3209,7 @@ static void DoClearTownHouseHelper(TileIndex tile, Town *t, HouseID house)
 {
 	assert_tile(IsTileType(tile, MP_HOUSE), tile);
 	DecreaseBuildingCount(t, house);
+	RemoveTileFromStationAcceptanceCaches(tile);
 	DoClearSquare(tile);
 	DeleteAnimatedTile(tile);
 
@@ -3189,6 +3428,7 @@ CommandCost CmdTownGrowthRate(TileIndex tile, DoCommandFlag flags, uint32 p1, ui
 			/* Just clear the flag, UpdateTownGrowth will determine a proper growth rate */
 			ClrBit(t->flags, TOWN_CUSTOM_GROWTH);
 		} else {
+			UnscheduleTownGrowth(t);
 			uint old_rate = t->growth_rate;
 			if (t->grow_counter >= old_rate) {
 				/* This also catches old_rate == 0 */
@@ -3538,7 +3778,9 @@ static CommandCost TownActionFundBuildings(Town *t, DoCommandFlag flags)
 		 * tick-perfect and gives player some time window where they can
 		 * spam funding with the exact same efficiency.
 		 */
+		UnscheduleTownGrowth(t);
 		t->grow_counter = std::min<uint16>(t->grow_counter, 2 * TOWN_GROWTH_TICKS - (t->growth_rate - t->grow_counter) % TOWN_GROWTH_TICKS);
+		ScheduleTownGrowth(t);
 
 		SetWindowDirty(WC_TOWN_VIEW, t->index);
 	}
@@ -3553,6 +3795,7 @@ static CommandCost TownActionBuyRights(Town *t, DoCommandFlag flags)
 	if (flags & DC_EXEC) {
 		t->exclusive_counter = 12;
 		t->exclusivity = _current_company;
+		InvalidateAllIndustryStationCandidates();
 
 		ModifyStationRatingAround(t->xy, _current_company, 130, 17);
 
@@ -3842,9 +4085,11 @@ static uint GetNormalGrowthRate(Town *t)
 static void UpdateTownGrowthRate(Town *t)
 {
 	if (HasBit(t->flags, TOWN_CUSTOM_GROWTH)) return;
+	UnscheduleTownGrowth(t);
 	uint old_rate = t->growth_rate;
 	t->growth_rate = GetNormalGrowthRate(t);
 	UpdateTownGrowCounter(t, old_rate);
+	ScheduleTownGrowth(t);
 	SetWindowDirty(WC_TOWN_VIEW, t->index);
 }
 
@@ -3855,9 +4100,11 @@ static void UpdateTownGrowthRate(Town *t)
 static void UpdateTownGrowth(Town *t)
 {
 	auto guard = scope_guard([t]() {
+		ScheduleTownGrowth(t);
 		SetWindowDirty(WC_TOWN_VIEW, t->index);
 	});
 
+	UnscheduleTownGrowth(t);
 	SetBit(t->flags, TOWN_IS_GROWING);
 	UpdateTownGrowthRate(t);
 	if (!HasBit(t->flags, TOWN_IS_GROWING)) return;
@@ -4138,7 +4385,10 @@ void TownsMonthlyLoop()
 		if (t->road_build_months != 0) t->road_build_months--;
 
 		if (t->exclusive_counter != 0) {
-			if (--t->exclusive_counter == 0) t->exclusivity = INVALID_COMPANY;
+			if (--t->exclusive_counter == 0) {
+				t->exclusivity = INVALID_COMPANY;
+				InvalidateAllIndustryStationCandidates();
+			}
 		}
 
 		UpdateTownAmounts(t);
@@ -24,6 +24,7 @@
 #include "scope_info.h"
 #include "vehicle_func.h"
 #include "date_func.h"
+#include "programmable_signals.h"
 
 #include <vector>
 #include <algorithm>
@@ -240,6 +241,15 @@ static bool TestStationCondition(StationID station, TraceRestrictItem item)
  */
 void TraceRestrictProgram::Execute(const Train* v, const TraceRestrictProgramInput &input, TraceRestrictProgramResult& out) const
 {
+	if (this->has_constant_result) {
+		out = this->constant_result;
+		return;
+	}
+
+	/* Signals depending on the slots and counters changed by this program are updated once, when it has finished,
+	 * which is before the train acts on the result. */
+	ProgrammableSignalDependantUpdateBatch progsig_update_batch;
+
 	// static to avoid needing to re-alloc/resize on each execution
 	static std::vector<TraceRestrictCondStackFlags> condstack;
 	condstack.clear();
@@ -261,6 +271,11 @@ void TraceRestrictProgram::Execute(const Train* v, const TraceRestrictProgramInp
 				if (condflags & TRCF_ELSE) {
 					// else
 					assert(!(condstack.back() & TRCSF_SEEN_ELSE));
+					if (condstack.back() & (TRCSF_DONE_IF | TRCSF_PARENT_INACTIVE)) {
+						// nothing else in this block can be active, go straight to the end if
+						i = this->jump_targets[i] - 1;
+						continue;
+					}
 					HandleCondition(condstack, condflags, true);
 					condstack.back() |= TRCSF_SEEN_ELSE;
 				} else {
@@ -268,6 +283,24 @@ void TraceRestrictProgram::Execute(const Train* v, const TraceRestrictProgramInp
 					condstack.pop_back();
 				}
 			} else {
+				if (condflags & (TRCF_OR | TRCF_ELSE)) {
+					assert(!condstack.empty());
+					if ((condflags & TRCF_OR) && (condstack.back() & TRCSF_ACTIVE)) {
+						// orif of an active block, the result would not change anything
+						if (IsTraceRestrictDoubleItem(item)) i++;
+						continue;
+					}
+					if (condstack.back() & (TRCSF_DONE_IF | TRCSF_PARENT_INACTIVE)) {
+						// elif/orif of a block which is already done, nothing else in this block can be active, go straight to the end if
+						i = this->jump_targets[i] - 1;
+						continue;
+					}
+				} else if (!condstack.empty() && !(condstack.back() & TRCSF_ACTIVE)) {
+					// nested if with an inactive parent, skip the whole block including its end if
+					i = this->jump_targets[i];
+					continue;
+				}
+
 				uint16 condvalue = GetTraceRestrictValue(item);
 				bool result = false;
 				switch(type) {
@@ -770,6 +803,64 @@ void TraceRestrictProgram::Execute(const Train* v, const TraceRestrictProgramInp
 	assert(condstack.empty());
 }
 
+/**
+ * Compile the current instruction list, this must be called whenever the instruction list is changed.
+ * This fills in the jump table used by Execute to skip over blocks which cannot be active,
+ * and pre-computes the program result if the program has no conditions and no side effects.
+ * The instruction list must have been successfully validated first.
+ */
+void TraceRestrictProgram::Compile()
+{
+	// static to avoid needing to re-alloc/resize on each compilation
+	static std::vector<uint32> pending_items; ///< Array offsets of if/elif/orif/else items of open blocks, awaiting their end if
+	static std::vector<uint32> block_starts;  ///< For each open block, the index of its first item in pending_items
+	pending_items.clear();
+	block_starts.clear();
+
+	this->jump_targets.assign(this->items.size(), 0);
+	this->has_constant_result = false;
+	bool reads_inputs = false;
+
+	size_t size = this->items.size();
+	for (size_t i = 0; i < size; i++) {
+		TraceRestrictItem item = this->items[i];
+		if (IsTraceRestrictConditional(item)) {
+			TraceRestrictItemType type = GetTraceRestrictType(item);
+			TraceRestrictCondFlags condflags = GetTraceRestrictCondFlags(item);
+			if (type == TRIT_COND_ENDIF && !(condflags & TRCF_ELSE)) {
+				// end if
+				assert(!block_starts.empty());
+				for (size_t j = block_starts.back(); j < pending_items.size(); j++) {
+					this->jump_targets[pending_items[j]] = (uint32)i;
+				}
+				pending_items.resize(block_starts.back());
+				block_starts.pop_back();
+			} else {
+				if (type != TRIT_COND_ENDIF && !(condflags & (TRCF_OR | TRCF_ELSE))) {
+					// if
+					block_starts.push_back((uint32)pending_items.size());
+				}
+				pending_items.push_back((uint32)i);
+			}
+
+			// all conditions other than end if read the train or the circumstances of execution
+			if (type != TRIT_COND_ENDIF && type != TRIT_COND_UNDEFINED) reads_inputs = true;
+		}
+		if (IsTraceRestrictDoubleItem(item)) i++;
+	}
+	assert(block_starts.empty());
+
+	const TraceRestrictProgramActionsUsedFlags side_effect_actions = TRPAUF_SLOT_ACQUIRE | TRPAUF_SLOT_RELEASE_BACK | TRPAUF_SLOT_RELEASE_FRONT |
+			TRPAUF_PBS_RES_END_SLOT | TRPAUF_CHANGE_COUNTER;
+	if (!reads_inputs && !(this->actions_used_flags & side_effect_actions)) {
+		/* Nothing which the program does depends on the train or the circumstances of execution, so execute it once now */
+		TraceRestrictProgramResult result;
+		this->Execute(nullptr, TraceRestrictProgramInput(INVALID_TILE, INVALID_TRACKDIR, nullptr, nullptr), result);
+		this->constant_result = result;
+		this->has_constant_result = true;
+	}
+}
+
 /**
  * Decrement ref count, only use when removing a mapping
  */
@@ -1535,6 +1626,7 @@ CommandCost CmdProgramSignalTraceRestrict(TileIndex tile, DoCommandFlag flags, u
 		// move in modified program
 		prog->items.swap(items);
 		prog->actions_used_flags = actions_used_flags;
+		prog->Compile();
 
 		if (prog->items.size() == 0 && prog->refcount == 1) {
 			// program is empty, and this tile is the only reference to it
@@ -1854,10 +1946,7 @@ void TraceRestrictSlot::Clear()
 }
 
 void TraceRestrictSlot::UpdateSignals() {
-	for (SignalReference sr : this->progsig_dependants) {
-		AddTrackToSignalBuffer(sr.tile, sr.track, GetTileOwner(sr.tile));
-		UpdateSignalsInBuffer();
-	}
+	UpdateProgrammableSignalDependants(this->progsig_dependants);
 }
 
 void TraceRestrictSlot::DeIndex(VehicleID id)
@@ -1934,6 +2023,7 @@ void TraceRestrictRemoveVehicleFromAllSlots(VehicleID vehicle_id)
 {
 	const auto range = slot_vehicle_index.equal_range(vehicle_id);
 
+	ProgrammableSignalDependantUpdateBatch progsig_update_batch;
 	for (auto it = range.first; it != range.second; ++it) {
 		auto slot = TraceRestrictSlot::Get(it->second);
 		container_unordered_remove(slot->occupants, vehicle_id);
@@ -2200,10 +2290,7 @@ void TraceRestrictCounter::UpdateValue(int32 new_value)
 	if (new_value != this->value) {
 		this->value = new_value;
 		InvalidateWindowClassesData(WC_TRACE_RESTRICT_COUNTERS);
-		for (SignalReference sr : this->progsig_dependants) {
-			AddTrackToSignalBuffer(sr.tile, sr.track, GetTileOwner(sr.tile));
-			UpdateSignalsInBuffer();
-		}
+		UpdateProgrammableSignalDependants(this->progsig_dependants);
 	}
 }
 
@@ -1039,7 +1039,14 @@ Train::MaxSpeedInfo Train::GetCurrentMaxSpeedInfoInternal(bool update_state) con
 			VehicleOrderID current_order_index = this->cur_real_order_index;
 			const Order *order = &(this->current_order);
 			StationID last_station_visited = this->last_station_visited;
+
+			/* Items which start beyond the longest possible braking distance of the train cannot limit the speed.
+			 * This is the distance from the current maximum speed to a stop, on the steepest descent to any item. */
+			int64 braking_horizon = (int64)this->lookahead->current_position + GetRealisticBrakingDistanceForSpeed(stats,
+					std::max(max_speed, advisory_max_speed), 0, std::min<int>(this->lookahead->lowest_item_z, stats.z_pos) - stats.z_pos);
 			for (const TrainReservationLookAheadItem &item : this->lookahead->items) {
+				/* Station items may still advance the predicted order, so must always be applied */
+				if (item.start > braking_horizon && item.type != TRLIT_STATION) continue;
 				ApplyLookAheadItem(this, item, max_speed, advisory_max_speed, current_order_index, order, last_station_visited, stats, this->lookahead->current_position);
 			}
 			if (HasBit(this->lookahead->flags, TRLF_APPLY_ADVISORY)) {
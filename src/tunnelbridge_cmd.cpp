@@ -2611,7 +2611,8 @@ static TrackStatus GetTileTrackStatus_TunnelBridge(TileIndex tile, TransportType
 	return CombineTrackStatus(TrackBitsToTrackdirBits(mode == TRANSPORT_RAIL ? GetTunnelBridgeTrackBits(tile) : DiagDirToDiagTrackBits(dir)), TRACKDIR_BIT_NONE);
 }
 
-static void UpdateRoadTunnelBridgeInfrastructure(TileIndex begin, TileIndex end, bool add) {
+template <typename F>
+static void UpdateRoadTunnelBridgeInfrastructure(TileIndex begin, TileIndex end, bool add, F get_infra) {
 	/* A full diagonal road has two road bits. */
 	const uint middle_len = 2 * GetTunnelBridgeLength(begin, end) * TUNNELBRIDGE_TRACKBIT_FACTOR;
 	const uint len = middle_len + (4 * TUNNELBRIDGE_TRACKBIT_FACTOR);
@@ -2619,7 +2620,7 @@ static void UpdateRoadTunnelBridgeInfrastructure(TileIndex begin, TileIndex end,
 	for (RoadTramType rtt : _roadtramtypes) {
 		RoadType rt = GetRoadType(begin, rtt);
 		if (rt == INVALID_ROADTYPE) continue;
-		Company * const c = Company::GetIfValid(GetRoadOwner(begin, rtt));
+		CompanyInfrastructure * const c = get_infra(GetRoadOwner(begin, rtt));
 		if (c != nullptr) {
 			uint infra = 0;
 			if (IsBridge(begin)) {
@@ -2632,16 +2633,16 @@ static void UpdateRoadTunnelBridgeInfrastructure(TileIndex begin, TileIndex end,
 				infra += len;
 			}
 			if (add) {
-				c->infrastructure.road[rt] += infra;
+				c->road[rt] += infra;
 			} else {
-				c->infrastructure.road[rt] -= infra;
+				c->road[rt] -= infra;
 			}
 		}
 	}
 	for (RoadTramType rtt : _roadtramtypes) {
 		RoadType rt = GetRoadType(end, rtt);
 		if (rt == INVALID_ROADTYPE) continue;
-		Company * const c = Company::GetIfValid(GetRoadOwner(end, rtt));
+		CompanyInfrastructure * const c = get_infra(GetRoadOwner(end, rtt));
 		if (c != nullptr) {
 			uint infra = 0;
 			if (IsBridge(end)) {
@@ -2649,40 +2650,50 @@ static void UpdateRoadTunnelBridgeInfrastructure(TileIndex begin, TileIndex end,
 				infra += CountBits(bits) * TUNNELBRIDGE_TRACKBIT_FACTOR;
 			}
 			if (add) {
-				c->infrastructure.road[rt] += infra;
+				c->road[rt] += infra;
 			} else {
-				c->infrastructure.road[rt] -= infra;
+				c->road[rt] -= infra;
 			}
 		}
 	}
 }
 
+static CompanyInfrastructure *GetCompanyInfrastructureIfValid(Owner owner) {
+	Company *c = Company::GetIfValid(owner);
+	return c != nullptr ? &c->infrastructure : nullptr;
+}
+
 void AddRoadTunnelBridgeInfrastructure(TileIndex begin, TileIndex end) {
-	UpdateRoadTunnelBridgeInfrastructure(begin, end, true);
+	UpdateRoadTunnelBridgeInfrastructure(begin, end, true, GetCompanyInfrastructureIfValid);
 }
 
 void SubtractRoadTunnelBridgeInfrastructure(TileIndex begin, TileIndex end) {
-	UpdateRoadTunnelBridgeInfrastructure(begin, end, false);
+	UpdateRoadTunnelBridgeInfrastructure(begin, end, false, GetCompanyInfrastructureIfValid);
+}
+
+/** Add the road infrastructure of a tunnel/bridge to the counts returned by \a get_infra for each road owner. */
+void AddRoadTunnelBridgeInfrastructure(TileIndex begin, TileIndex end, const std::function<CompanyInfrastructure *(Owner)> &get_infra) {
+	UpdateRoadTunnelBridgeInfrastructure(begin, end, true, get_infra);
 }
 
-static void UpdateRailTunnelBridgeInfrastructure(Company *c, TileIndex begin, TileIndex end, bool add) {
+static void UpdateRailTunnelBridgeInfrastructure(CompanyInfrastructure *c, TileIndex begin, TileIndex end, bool add) {
 	const uint middle_len = GetTunnelBridgeLength(begin, end) * TUNNELBRIDGE_TRACKBIT_FACTOR;
 
 	if (c != nullptr) {
 		uint primary_count = middle_len + GetTunnelBridgeHeadOnlyPrimaryRailInfrastructureCount(begin) + GetTunnelBridgeHeadOnlyPrimaryRailInfrastructureCount(end);
 		if (add) {
-			c->infrastructure.rail[GetRailType(begin)] += primary_count;
+			c->rail[GetRailType(begin)] += primary_count;
 		} else {
-			c->infrastructure.rail[GetRailType(begin)] -= primary_count;
+			c->rail[GetRailType(begin)] -= primary_count;
 		}
 
 		auto add_secondary_railtype = [&](TileIndex t) {
 			uint secondary_count = GetTunnelBridgeHeadOnlySecondaryRailInfrastructureCount(t);
 			if (secondary_count) {
 				if (add) {
-					c->infrastructure.rail[GetSecondaryRailType(t)] += secondary_count;
+					c->rail[GetSecondaryRailType(t)] += secondary_count;
 				} else {
-					c->infrastructure.rail[GetSecondaryRailType(t)] -= secondary_count;
+					c->rail[GetSecondaryRailType(t)] -= secondary_count;
 				}
 			}
 		};
@@ -2691,28 +2702,33 @@ static void UpdateRailTunnelBridgeInfrastructure(Company *c, TileIndex begin, Ti
 
 		if (IsTunnelBridgeWithSignalSimulation(begin)) {
 			if (add) {
-				c->infrastructure.signal += GetTunnelBridgeSignalSimulationSignalCount(begin, end);
+				c->signal += GetTunnelBridgeSignalSimulationSignalCount(begin, end);
 			} else {
-				c->infrastructure.signal -= GetTunnelBridgeSignalSimulationSignalCount(begin, end);
+				c->signal -= GetTunnelBridgeSignalSimulationSignalCount(begin, end);
 			}
 		}
 	}
 }
 
 void AddRailTunnelBridgeInfrastructure(Company *c, TileIndex begin, TileIndex end) {
-	UpdateRailTunnelBridgeInfrastructure(c, begin, end, true);
+	UpdateRailTunnelBridgeInfrastructure(c != nullptr ? &c->infrastructure : nullptr, begin, end, true);
 }
 
 void SubtractRailTunnelBridgeInfrastructure(Company *c, TileIndex begin, TileIndex end) {
-	UpdateRailTunnelBridgeInfrastructure(c, begin, end, false);
+	UpdateRailTunnelBridgeInfrastructure(c != nullptr ? &c->infrastructure : nullptr, begin, end, false);
 }
 
 void AddRailTunnelBridgeInfrastructure(TileIndex begin, TileIndex end) {
-	UpdateRailTunnelBridgeInfrastructure(Company::GetIfValid(GetTileOwner(begin)), begin, end, true);
+	UpdateRailTunnelBridgeInfrastructure(GetCompanyInfrastructureIfValid(GetTileOwner(begin)), begin, end, true);
 }
 
 void SubtractRailTunnelBridgeInfrastructure(TileIndex begin, TileIndex end) {
-	UpdateRailTunnelBridgeInfrastructure(Company::GetIfValid(GetTileOwner(begin)), begin, end, false);
+	UpdateRailTunnelBridgeInfrastructure(GetCompanyInfrastructureIfValid(GetTileOwner(begin)), begin, end, false);
+}
+
+/** Add the rail infrastructure of a tunnel/bridge to \a infra, leaving the company caches untouched. */
+void AddRailTunnelBridgeInfrastructure(CompanyInfrastructure &infra, TileIndex begin, TileIndex end) {
+	UpdateRailTunnelBridgeInfrastructure(&infra, begin, end, true);
 }
 
 static void ChangeTileOwner_TunnelBridge(TileIndex tile, Owner old_owner, Owner new_owner)
@@ -20,6 +20,8 @@
 #include "vehicle_type.h"
 #include "core/bitmath_func.hpp"
 
+#include <functional>
+
 
 /**
  * Get the direction pointing to the other end.
@@ -512,5 +514,7 @@ void AddRailTunnelBridgeInfrastructure(TileIndex begin, TileIndex end);
 void SubtractRailTunnelBridgeInfrastructure(TileIndex begin, TileIndex end);
 void AddRoadTunnelBridgeInfrastructure(TileIndex begin, TileIndex end);
 void SubtractRoadTunnelBridgeInfrastructure(TileIndex begin, TileIndex end);
+void AddRailTunnelBridgeInfrastructure(CompanyInfrastructure &infra, TileIndex begin, TileIndex end);
+void AddRoadTunnelBridgeInfrastructure(TileIndex begin, TileIndex end, const std::function<CompanyInfrastructure *(Owner)> &get_infra);
 
 #endif /* TUNNELBRIDGE_MAP_H */
@@ -44,6 +44,7 @@
 #include "sound_func.h"
 #include "effectvehicle_func.h"
 #include "effectvehicle_base.h"
+#include "disaster_vehicle.h"
 #include "vehiclelist.h"
 #include "bridge_map.h"
 #include "tunnel_map.h"
@@ -1206,6 +1207,15 @@ void Vehicle::PreCleanPool()
 	pending_speed_restriction_change_map.clear();
 }
 
+/**
+ * Size of the slots of the vehicle pool, which must fit any type of vehicle.
+ * @return size of the largest vehicle type
+ */
+size_t Vehicle::GetPoolSlotSize()
+{
+	return std::max({ sizeof(Train), sizeof(RoadVehicle), sizeof(Ship), sizeof(Aircraft), sizeof(EffectVehicle), sizeof(DisasterVehicle) });
+}
+
 /**
  * Adds a vehicle to the list of vehicles that visited a depot this tick
  * @param *v vehicle to add
@@ -1427,6 +1437,9 @@ void CallVehicleTicks()
 
 	if (_tick_skip_counter == 0) RunVehicleDayProc();
 
+	/* Vehicles sharing orders which load, unload or leave stations in the same tick would refresh the same links */
+	LinkRefresher::BeginBatch();
+
 	{
 		PerformanceMeasurer framerate(PFE_GL_ECONOMY);
 		Station *si_st = nullptr;
@@ -1516,6 +1529,8 @@ void CallVehicleTicks()
 	}
 	v = nullptr;
 
+	LinkRefresher::EndBatch();
+
 	/* do Template Replacement */
 	Backup<CompanyID> sell_cur_company(_current_company, FILE_LINE);
 	for (VehicleID index : _vehicles_to_sell) {
@@ -2543,7 +2558,7 @@ void VehicleEnterDepot(Vehicle *v)
 void Vehicle::UpdateViewport(bool dirty)
 {
 	/* Skip updating sprites on dedicated servers without screen */
-	if (_network_dedicated) return;
+	if (IsHeadless()) return;
 
 	Rect new_coord = ConvertRect<Rect16, Rect>(this->sprite_seq_bounds);
 
@@ -227,7 +227,7 @@ struct PendingSpeedRestrictionChange {
 extern std::unordered_multimap<VehicleID, PendingSpeedRestrictionChange> pending_speed_restriction_change_map;
 
 /** A vehicle pool for a little over 1 million vehicles. */
-typedef Pool<Vehicle, VehicleID, 512, 0xFF000> VehiclePool;
+typedef Pool<Vehicle, VehicleID, 512, 0xFF000, PT_NORMAL, false, true, true> VehiclePool;
 extern VehiclePool _vehicle_pool;
 
 /* Some declarations of functions, so we can make them friendly */
@@ -259,6 +259,7 @@ public:
 	friend bool LoadOldVehicle(LoadgameState *ls, int num);       ///< So we can set the proper next pointer while loading
 
 	static void PreCleanPool();
+	static size_t GetPoolSlotSize();
 
 	TileIndex tile;                     ///< Current tile index
 
@@ -1416,7 +1417,7 @@ public:
 	inline void UpdateViewport(bool force_update, bool update_delta)
 	{
 		/* Skip updating sprites on dedicated servers without screen */
-		if (_network_dedicated) return;
+		if (IsHeadless()) return;
 
 		/* Explicitly choose method to call to prevent vtable dereference -
 		 * it gives ~3% runtime improvements in games with many vehicles */
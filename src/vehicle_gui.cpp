@@ -41,6 +41,7 @@
 #include "zoom_func.h"
 #include "tracerestrict.h"
 #include "depot_base.h"
+#include "3rdparty/cpp-btree/btree_map.h"
 
 #include <vector>
 #include <algorithm>
@@ -228,6 +229,13 @@ void BaseVehicleListWindow::BuildVehicleList()
 
 	DEBUG(misc, 3, "Building vehicle list type %d for company %d given index %d", this->vli.type, this->vli.company, this->vli.index);
 
+	/* Remember the previous order of the list, so that only added and changed entries need to be moved by the next resort.
+	 * The vehicle pointers are only used as keys, as the vehicles may no longer exist. */
+	btree::btree_map<const Vehicle *, uint> previous_positions;
+	for (uint i = 0; i < this->vehgroups.size(); i++) {
+		previous_positions.insert({ *(this->vehgroups[i].vehicles_begin), i });
+	}
+
 	this->vehgroups.clear();
 
 	GenerateVehicleSortList(&this->vehicles, this->vli);
@@ -263,6 +271,22 @@ void BaseVehicleListWindow::BuildVehicleList()
 
 		this->unitnumber_digits = CountDigitsForAllocatingSpace(max_num_vehicles);
 	}
+
+	if (!previous_positions.empty()) {
+		std::vector<std::pair<uint, GUIVehicleGroup>> ordered;
+		ordered.reserve(this->vehgroups.size());
+		for (const GUIVehicleGroup &vg : this->vehgroups) {
+			auto iter = previous_positions.find(*(vg.vehicles_begin));
+			ordered.emplace_back(iter != previous_positions.end() ? iter->second : UINT_MAX, vg);
+		}
+		std::stable_sort(ordered.begin(), ordered.end(), [](const std::pair<uint, GUIVehicleGroup> &a, const std::pair<uint, GUIVehicleGroup> &b) {
+			return a.first < b.first;
+		});
+		for (uint i = 0; i < ordered.size(); i++) {
+			this->vehgroups[i] = ordered[i].second;
+		}
+	}
+
 	this->FilterVehicleList();
 	this->CountOwnVehicles();
 
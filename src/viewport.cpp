@@ -1841,6 +1841,13 @@ static void ViewportAddKdtreeSigns(DrawPixelInfo *dpi, bool towns_only)
  */
 void ViewportSign::UpdatePosition(ZoomLevel maxzoom, int center, int top, StringID str, StringID str_small)
 {
+	/* Skip formatting and measuring the sign on dedicated servers without screen */
+	if (IsHeadless()) {
+		this->top = top;
+		this->center = center;
+		return;
+	}
+
 	if (this->width_normal != 0) this->MarkDirty(maxzoom);
 
 	this->top = top;
@@ -3694,6 +3701,7 @@ void MarkAllViewportMapsDirty(int left, int top, int right, int bottom)
 
 void MarkAllViewportMapLandscapesDirty()
 {
+	InvalidateSmallMapColours();
 	for (Window *w : Window::IterateFromBack()) {
 		Viewport *vp = w->viewport;
 		if (vp != nullptr && vp->zoom >= ZOOM_LVL_DRAW_MAP) {
@@ -3751,6 +3759,10 @@ void ConstrainAllViewportsZoom()
  */
 void MarkTileDirtyByTile(TileIndex tile, ViewportMarkDirtyFlags flags, int bridge_level_offset, int tile_height_override)
 {
+	/* Skip marking dirty on dedicated servers without screen */
+	if (IsHeadless()) return;
+
+	if (!(flags & (VMDF_NOT_MAP_MODE | VMDF_NOT_LANDSCAPE))) InvalidateSmallMapTileColour(tile);
 	Point pt = RemapCoords(TileX(tile) * TILE_SIZE, TileY(tile) * TILE_SIZE, tile_height_override * TILE_HEIGHT);
 	MarkAllViewportsDirty(
 			pt.x - 31  * ZOOM_LVL_BASE,
@@ -3763,6 +3775,10 @@ void MarkTileDirtyByTile(TileIndex tile, ViewportMarkDirtyFlags flags, int bridg
 
 void MarkTileGroundDirtyByTile(TileIndex tile, ViewportMarkDirtyFlags flags)
 {
+	/* Skip marking dirty on dedicated servers without screen */
+	if (IsHeadless()) return;
+
+	if (!(flags & (VMDF_NOT_MAP_MODE | VMDF_NOT_LANDSCAPE))) InvalidateSmallMapTileColour(tile);
 	int x = TileX(tile) * TILE_SIZE;
 	int y = TileY(tile) * TILE_SIZE;
 	Point top = RemapCoords(x, y, GetTileMaxPixelZ(tile));
@@ -4184,7 +4200,7 @@ void RebuildViewportKdtree()
 	/* Reset biggest size sign seen */
 	_viewport_sign_maxwidth = 0;
 
-	if (_network_dedicated) {
+	if (IsHeadless()) {
 		_viewport_sign_kdtree_valid = false;
 		_viewport_sign_kdtree.Build<ViewportSignKdtreeItem*>(nullptr, nullptr);
 		return;
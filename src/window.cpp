@@ -1960,7 +1960,7 @@ static void DecreaseWindowCounters()
 	if (hundredth_tick_timeout != 0) hundredth_tick_timeout--;
 
 	for (Window *w : Window::IterateFromFront()) {
-		if (!_network_dedicated && hundredth_tick_timeout == 0) w->OnHundredthTick();
+		if (!IsHeadless() && hundredth_tick_timeout == 0) w->OnHundredthTick();
 
 		if (_scroller_click_timeout == 0) {
 			/* Unclick scrollbar buttons if they are pressed. */
@@ -3231,7 +3231,7 @@ void UpdateWindows()
 
 	/* Skip the actual drawing on dedicated servers without screen.
 	 * But still empty the invalidation queues above. */
-	if (_network_dedicated) return;
+	if (IsHeadless()) return;
 
 	if (window_timer.HasElapsed()) {
 		window_timer.SetInterval(MILLISECONDS_PER_TICK);